@@ -0,0 +1,537 @@
+#include "BatchLoader.hpp"
+
+#include "InputFile.hpp"
+#include "MappedFile.hpp"
+#include "narrow.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+#if !defined(_WIN32)
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+    #define AOC_HAS_IO_URING 1
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+#else
+    #define AOC_HAS_IO_URING 0
+#endif
+
+namespace aoc
+{
+namespace
+{
+//==============================================================================
+constexpr std::size_t UNKNOWN_SIZE_CHUNK = 64 * 1024;
+
+//==============================================================================
+struct Loaded_Input {
+    std::size_t index;
+    std::vector<char> bytes;
+};
+
+//==============================================================================
+// Solver threads fed through a bounded queue : the loader blocks when the solvers fall behind.
+class Solver_Pool
+{
+    BatchLoader::Callback const & m_callback;
+    std::size_t m_capacity;
+    std::deque<Loaded_Input> m_queue{};
+    std::mutex m_mutex{};
+    std::condition_variable m_not_empty{};
+    std::condition_variable m_not_full{};
+    bool m_is_closed{};
+    std::vector<std::thread> m_threads{};
+
+public:
+    //==============================================================================
+    Solver_Pool(BatchLoader::Callback const & callback, unsigned const num_threads)
+        : m_callback(callback)
+        , m_capacity(num_threads * std::size_t{ 2 })
+    {
+        m_threads.reserve(num_threads);
+        for (unsigned i{}; i < num_threads; ++i) {
+            m_threads.emplace_back([this] { work(); });
+        }
+    }
+    ~Solver_Pool() { close(); }
+    //==============================================================================
+    Solver_Pool(Solver_Pool const &) = delete;
+    Solver_Pool(Solver_Pool &&) = delete;
+    Solver_Pool & operator=(Solver_Pool const &) = delete;
+    Solver_Pool & operator=(Solver_Pool &&) = delete;
+    //==============================================================================
+    void push(Loaded_Input input)
+    {
+        std::unique_lock lock{ m_mutex };
+        m_not_full.wait(lock, [this] { return m_queue.size() < m_capacity; });
+        m_queue.push_back(std::move(input));
+        lock.unlock();
+        m_not_empty.notify_one();
+    }
+    //==============================================================================
+    // Waits until every queued input is solved.
+    void close()
+    {
+        {
+            std::lock_guard const lock{ m_mutex };
+            m_is_closed = true;
+        }
+        m_not_empty.notify_all();
+        for (auto & thread : m_threads) {
+            thread.join();
+        }
+        m_threads.clear();
+    }
+
+private:
+    //==============================================================================
+    void work()
+    {
+        while (true) {
+            std::unique_lock lock{ m_mutex };
+            m_not_empty.wait(lock, [this] { return !m_queue.empty() || m_is_closed; });
+            if (m_queue.empty()) {
+                return;
+            }
+            auto const input{ std::move(m_queue.front()) };
+            m_queue.pop_front();
+            lock.unlock();
+            m_not_full.notify_one();
+
+            m_callback(input.index, StringView{ input.bytes.data(), input.bytes.size() });
+        }
+    }
+};
+
+//==============================================================================
+[[nodiscard]] std::vector<char> read_whole_file(char const * path)
+{
+#if !defined(_WIN32)
+    if (InputFile::is_stream_path(path)) {
+#endif
+        // the standard input and borrowed descriptors can't be (re)opened by path
+        MappedFile const file{ path };
+        return std::vector<char>(file.data(), file.data() + file.size());
+#if !defined(_WIN32)
+    }
+
+    std::vector<char> bytes{};
+
+    auto const fd{ ::open(path, O_RDONLY | O_CLOEXEC) };
+    if (fd < 0) {
+        return bytes;
+    }
+
+    struct stat file_status {
+    };
+    auto const is_regular{ ::fstat(fd, &file_status) == 0 && S_ISREG(file_status.st_mode) };
+    bytes.resize(is_regular ? static_cast<std::size_t>(file_status.st_size) : UNKNOWN_SIZE_CHUNK);
+
+    std::size_t filled{};
+    while (filled < bytes.size() || !is_regular) {
+        if (filled == bytes.size()) {
+            bytes.resize(bytes.size() * 2);
+        }
+        auto const bytes_read{ is_regular ? ::pread(fd, bytes.data() + filled, bytes.size() - filled, filled)
+                                          : ::read(fd, bytes.data() + filled, bytes.size() - filled) };
+        if (bytes_read < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes_read <= 0) {
+            break;
+        }
+        filled += static_cast<std::size_t>(bytes_read);
+    }
+    bytes.resize(filled);
+
+    ::close(fd);
+    return bytes;
+#endif
+}
+
+//==============================================================================
+void load_with_threads(std::vector<char const *> const & paths, Solver_Pool & pool, unsigned const num_threads)
+{
+    std::atomic<std::size_t> next_path{};
+    auto const load = [&] {
+        for (auto index{ next_path++ }; index < paths.size(); index = next_path++) {
+            pool.push(Loaded_Input{ index, read_whole_file(paths[index]) });
+        }
+    };
+
+    std::vector<std::thread> loaders{};
+    auto const num_loaders{ std::min<std::size_t>(num_threads, paths.size()) };
+    loaders.reserve(num_loaders);
+    for (std::size_t i{}; i < num_loaders; ++i) {
+        loaders.emplace_back(load);
+    }
+    for (auto & loader : loaders) {
+        loader.join();
+    }
+}
+
+#if AOC_HAS_IO_URING
+//==============================================================================
+// Bare-bones io_uring, straight on top of the system calls so that liburing isn't needed.
+class Io_Uring
+{
+    int m_fd{ -1 };
+    unsigned m_sq_entries{};
+    void * m_sq_ring{ MAP_FAILED };
+    std::size_t m_sq_ring_size{};
+    void * m_cq_ring{ MAP_FAILED };
+    std::size_t m_cq_ring_size{};
+    void * m_sqes_memory{ MAP_FAILED };
+    std::size_t m_sqes_size{};
+
+    unsigned * m_sq_head{};
+    unsigned * m_sq_tail{};
+    unsigned m_sq_mask{};
+    unsigned * m_sq_array{};
+    io_uring_sqe * m_sqes{};
+    unsigned m_local_sq_tail{};
+    unsigned m_to_submit{};
+
+    unsigned * m_cq_head{};
+    unsigned * m_cq_tail{};
+    unsigned m_cq_mask{};
+    io_uring_cqe * m_cqes{};
+
+public:
+    //==============================================================================
+    explicit Io_Uring(unsigned const entries)
+    {
+        io_uring_params params{};
+        m_fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (m_fd < 0) {
+            return;
+        }
+        m_sq_entries = params.sq_entries;
+
+        m_sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        m_cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        auto const is_single_mmap{ (params.features & IORING_FEAT_SINGLE_MMAP) != 0 };
+        if (is_single_mmap) {
+            m_sq_ring_size = m_cq_ring_size = std::max(m_sq_ring_size, m_cq_ring_size);
+        }
+
+        static constexpr auto PROTECTION{ PROT_READ | PROT_WRITE };
+        static constexpr auto FLAGS{ MAP_SHARED | MAP_POPULATE };
+        m_sq_ring = ::mmap(nullptr, m_sq_ring_size, PROTECTION, FLAGS, m_fd, IORING_OFF_SQ_RING);
+        if (m_sq_ring == MAP_FAILED) {
+            return;
+        }
+        m_cq_ring = is_single_mmap ? m_sq_ring
+                                   : ::mmap(nullptr, m_cq_ring_size, PROTECTION, FLAGS, m_fd, IORING_OFF_CQ_RING);
+        if (m_cq_ring == MAP_FAILED) {
+            return;
+        }
+        m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        m_sqes_memory = ::mmap(nullptr, m_sqes_size, PROTECTION, FLAGS, m_fd, IORING_OFF_SQES);
+        if (m_sqes_memory == MAP_FAILED) {
+            return;
+        }
+
+        auto * const sq{ static_cast<char *>(m_sq_ring) };
+        m_sq_head = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+        m_sq_tail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+        m_sq_mask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+        m_sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+        m_sqes = static_cast<io_uring_sqe *>(m_sqes_memory);
+        m_local_sq_tail = *m_sq_tail;
+
+        auto * const cq{ static_cast<char *>(m_cq_ring) };
+        m_cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+        m_cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+        m_cq_mask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+        m_cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+    }
+    //==============================================================================
+    ~Io_Uring()
+    {
+        if (m_sqes_memory != MAP_FAILED) {
+            ::munmap(m_sqes_memory, m_sqes_size);
+        }
+        if (m_cq_ring != MAP_FAILED && m_cq_ring != m_sq_ring) {
+            ::munmap(m_cq_ring, m_cq_ring_size);
+        }
+        if (m_sq_ring != MAP_FAILED) {
+            ::munmap(m_sq_ring, m_sq_ring_size);
+        }
+        if (m_fd >= 0) {
+            ::close(m_fd);
+        }
+    }
+    //==============================================================================
+    Io_Uring(Io_Uring const &) = delete;
+    Io_Uring(Io_Uring &&) = delete;
+    Io_Uring & operator=(Io_Uring const &) = delete;
+    Io_Uring & operator=(Io_Uring &&) = delete;
+    //==============================================================================
+    [[nodiscard]] bool is_valid() const noexcept { return m_fd >= 0 && m_sqes_memory != MAP_FAILED; }
+    //==============================================================================
+    [[nodiscard]] bool supports(std::initializer_list<unsigned> const opcodes) const
+    {
+        static constexpr unsigned MAX_OPS = 256;
+        std::vector<char> storage(sizeof(io_uring_probe) + MAX_OPS * sizeof(io_uring_probe_op));
+        auto * const probe{ reinterpret_cast<io_uring_probe *>(storage.data()) };
+        if (::syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_PROBE, probe, MAX_OPS) < 0) {
+            return false;
+        }
+        return std::all_of(opcodes.begin(), opcodes.end(), [&](unsigned const opcode) {
+            return opcode <= probe->last_op && (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED) != 0;
+        });
+    }
+    //==============================================================================
+    // Zeroed submission entry, or nullptr when the submission queue is full.
+    [[nodiscard]] io_uring_sqe * get_sqe() noexcept
+    {
+        auto const head{ __atomic_load_n(m_sq_head, __ATOMIC_ACQUIRE) };
+        if (m_local_sq_tail - head >= m_sq_entries) {
+            return nullptr;
+        }
+        auto const index{ m_local_sq_tail & m_sq_mask };
+        auto * const sqe{ &m_sqes[index] };
+        std::memset(sqe, 0, sizeof(io_uring_sqe));
+        m_sq_array[index] = index;
+        ++m_local_sq_tail;
+        ++m_to_submit;
+        return sqe;
+    }
+    //==============================================================================
+    void submit_and_wait(unsigned const min_complete) noexcept(!detail::IS_DEBUG)
+    {
+        __atomic_store_n(m_sq_tail, m_local_sq_tail, __ATOMIC_RELEASE);
+        while (true) {
+            auto const result{
+                ::syscall(__NR_io_uring_enter, m_fd, m_to_submit, min_complete, IORING_ENTER_GETEVENTS, nullptr, 0)
+            };
+            if (result < 0 && errno == EINTR) {
+                continue;
+            }
+            assert(result >= 0);
+            if (result > 0) {
+                m_to_submit -= static_cast<unsigned>(result);
+            }
+            return;
+        }
+    }
+    //==============================================================================
+    template<typename Func>
+    void for_each_completion(Func const & func)
+    {
+        auto head{ *m_cq_head };
+        auto const tail{ __atomic_load_n(m_cq_tail, __ATOMIC_ACQUIRE) };
+        for (; head != tail; ++head) {
+            func(m_cqes[head & m_cq_mask]);
+        }
+        __atomic_store_n(m_cq_head, head, __ATOMIC_RELEASE);
+    }
+};
+
+//==============================================================================
+constexpr std::initializer_list<unsigned> REQUIRED_OPCODES{ IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_CLOSE };
+
+//==============================================================================
+// Every input goes through openat -> read (as many as needed) -> close, with one operation in flight per slot.
+[[nodiscard]] bool
+    load_with_io_uring(std::vector<char const *> const & paths, Solver_Pool & pool, unsigned const queue_depth)
+{
+    Io_Uring ring{ queue_depth };
+    if (!ring.is_valid() || !ring.supports(REQUIRED_OPCODES)) {
+        return false;
+    }
+
+    enum class Stage { opening, reading, closing };
+
+    struct Slot {
+        std::size_t index;
+        Stage stage;
+        int fd;
+        bool is_regular;
+        std::size_t filled;
+        std::vector<char> bytes;
+    };
+
+    std::vector<Slot> slots{};
+    slots.resize(queue_depth);
+    std::vector<unsigned> free_slots{};
+    free_slots.resize(queue_depth);
+    std::iota(free_slots.rbegin(), free_slots.rend(), 0u);
+
+    std::size_t next_path{};
+    unsigned busy_slots{};
+
+    auto const queue_read = [&](unsigned const slot_index) {
+        auto & slot{ slots[slot_index] };
+        auto * const sqe{ ring.get_sqe() };
+        assert(sqe);
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = slot.fd;
+        sqe->addr = reinterpret_cast<std::uintptr_t>(slot.bytes.data() + slot.filled);
+        sqe->len = static_cast<std::uint32_t>(std::min<std::size_t>(slot.bytes.size() - slot.filled, UINT32_MAX));
+        // -1 reads at the current position, which is the only option for pipes
+        sqe->off = slot.is_regular ? slot.filled : ~std::uint64_t{};
+        sqe->user_data = slot_index;
+        slot.stage = Stage::reading;
+    };
+
+    auto const release_slot = [&](unsigned const slot_index) {
+        free_slots.push_back(slot_index);
+        --busy_slots;
+    };
+
+    auto const finish = [&](unsigned const slot_index) {
+        auto & slot{ slots[slot_index] };
+        slot.bytes.resize(slot.filled);
+        pool.push(Loaded_Input{ slot.index, std::move(slot.bytes) });
+
+        auto * const sqe{ ring.get_sqe() };
+        assert(sqe);
+        sqe->opcode = IORING_OP_CLOSE;
+        sqe->fd = slot.fd;
+        sqe->user_data = slot_index;
+        slot.stage = Stage::closing;
+    };
+
+    auto const on_completion = [&](io_uring_cqe const & cqe) {
+        auto const slot_index{ static_cast<unsigned>(cqe.user_data) };
+        auto & slot{ slots[slot_index] };
+
+        switch (slot.stage) {
+        case Stage::opening: {
+            if (cqe.res < 0) {
+                pool.push(Loaded_Input{ slot.index, {} });
+                release_slot(slot_index);
+                return;
+            }
+            slot.fd = cqe.res;
+            struct stat file_status {
+            };
+            slot.is_regular = ::fstat(slot.fd, &file_status) == 0 && S_ISREG(file_status.st_mode);
+            slot.bytes.resize(slot.is_regular ? static_cast<std::size_t>(file_status.st_size) : UNKNOWN_SIZE_CHUNK);
+            if (slot.bytes.empty()) {
+                finish(slot_index);
+                return;
+            }
+            queue_read(slot_index);
+            return;
+        }
+        case Stage::reading:
+            if (cqe.res <= 0) {
+                // end of file (or read error : keep what was read)
+                finish(slot_index);
+                return;
+            }
+            slot.filled += static_cast<std::size_t>(cqe.res);
+            if (slot.filled == slot.bytes.size()) {
+                if (slot.is_regular) {
+                    finish(slot_index);
+                    return;
+                }
+                slot.bytes.resize(slot.bytes.size() * 2);
+            }
+            queue_read(slot_index);
+            return;
+        case Stage::closing:
+            release_slot(slot_index);
+            return;
+        }
+        assert(false);
+    };
+
+    while (next_path < paths.size() || busy_slots > 0) {
+        while (next_path < paths.size() && !free_slots.empty()) {
+            if (InputFile::is_stream_path(paths[next_path])) {
+                pool.push(Loaded_Input{ next_path, read_whole_file(paths[next_path]) });
+                ++next_path;
+                continue;
+            }
+            auto * const sqe{ ring.get_sqe() };
+            if (sqe == nullptr) {
+                break;
+            }
+            auto const slot_index{ free_slots.back() };
+            free_slots.pop_back();
+            ++busy_slots;
+            slots[slot_index] = Slot{ next_path, Stage::opening, -1, false, 0, {} };
+
+            sqe->opcode = IORING_OP_OPENAT;
+            sqe->fd = AT_FDCWD;
+            sqe->addr = reinterpret_cast<std::uintptr_t>(paths[next_path]);
+            sqe->open_flags = O_RDONLY | O_CLOEXEC;
+            sqe->user_data = slot_index;
+            ++next_path;
+        }
+
+        if (busy_slots == 0) {
+            // only streams came up, and they were read in place : nothing to wait for
+            continue;
+        }
+        ring.submit_and_wait(1);
+        ring.for_each_completion(on_completion);
+    }
+
+    return true;
+}
+#endif
+
+} // namespace
+
+//==============================================================================
+BatchLoader::BatchLoader(Backend const backend, unsigned const queue_depth, unsigned const num_solver_threads)
+    : m_backend(backend)
+    , m_queue_depth(std::max(queue_depth, 1u))
+    , m_num_solver_threads(num_solver_threads)
+{
+    if (m_backend != Backend::threads) {
+        m_backend = is_io_uring_available() ? Backend::io_uring : Backend::threads;
+    }
+    if (m_num_solver_threads == 0) {
+        m_num_solver_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+}
+
+//==============================================================================
+void BatchLoader::run(std::vector<char const *> const & paths, Callback const & callback) const
+{
+    Solver_Pool pool{ callback, m_num_solver_threads };
+
+#if AOC_HAS_IO_URING
+    if (m_backend == Backend::io_uring && load_with_io_uring(paths, pool, m_queue_depth)) {
+        pool.close();
+        return;
+    }
+#endif
+
+    load_with_threads(paths, pool, m_queue_depth);
+    pool.close();
+}
+
+//==============================================================================
+bool BatchLoader::is_io_uring_available() noexcept
+{
+#if AOC_HAS_IO_URING
+    Io_Uring const ring{ 1 };
+    return ring.is_valid() && ring.supports(REQUIRED_OPCODES);
+#else
+    return false;
+#endif
+}
+
+} // namespace aoc
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "StringView.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace aoc
+{
+//==============================================================================
+// Loads many inputs concurrently and hands each one to a pool of solver threads as soon as its bytes are in.
+//
+// On Linux, an io_uring keeps up to queue_depth opens and reads in flight from a single loader thread. Where io_uring
+// is unavailable (old kernels, seccomp filters, other platforms), queue_depth loader threads do blocking open + pread
+// instead.
+//
+// Inputs that can't be opened are handed to the callback as empty views.
+class BatchLoader
+{
+public:
+    //==============================================================================
+    enum class Backend { automatic, io_uring, threads };
+    //==============================================================================
+    using Callback = std::function<void(std::size_t input_index, StringView const & contents)>;
+    //==============================================================================
+    static constexpr unsigned DEFAULT_QUEUE_DEPTH = 64;
+
+private:
+    Backend m_backend;
+    unsigned m_queue_depth;
+    unsigned m_num_solver_threads;
+
+public:
+    //==============================================================================
+    // num_solver_threads == 0 uses every core.
+    explicit BatchLoader(Backend backend = Backend::automatic,
+                         unsigned queue_depth = DEFAULT_QUEUE_DEPTH,
+                         unsigned num_solver_threads = 0);
+    //==============================================================================
+    // Calls callback once per path, from the solver threads, and returns when every input was handled. The contents
+    // are only valid during the call.
+    void run(std::vector<char const *> const & paths, Callback const & callback) const;
+    //==============================================================================
+    // The backend that run() will actually use.
+    [[nodiscard]] Backend backend() const noexcept { return m_backend; }
+    [[nodiscard]] static bool is_io_uring_available() noexcept;
+};
+
+} // namespace aoc
@@ -0,0 +1,172 @@
+#include "BinaryCache.hpp"
+
+#include "InputFile.hpp"
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+namespace aoc
+{
+namespace
+{
+//==============================================================================
+constexpr std::array<char, 8> MAGIC{ 'A', 'O', 'C', 'B', 'I', 'N', '\0', '\0' };
+constexpr std::uint32_t FORMAT_VERSION = 2;
+
+//==============================================================================
+struct Header {
+    std::array<char, 8> magic;
+    std::uint32_t format_version;
+    std::uint32_t schema_id;
+    std::uint32_t schema_version;
+    std::uint32_t reserved;
+    std::uint64_t source_size;
+    std::int64_t source_modification_time;
+    std::uint64_t source_hash;
+    std::uint64_t payload_size;
+};
+
+// The payload starts on its own cache line so that BinaryReader can align arrays relative to it.
+constexpr std::size_t PAYLOAD_OFFSET = 64;
+static_assert(sizeof(Header) <= PAYLOAD_OFFSET);
+static_assert(PAYLOAD_OFFSET % BinaryWriter::CACHE_ALIGNMENT == 0);
+
+//==============================================================================
+[[nodiscard]] Header make_header(Cache_Schema const & schema,
+                                 BinaryCache::Source_Info const & source_info,
+                                 std::uint64_t const source_hash,
+                                 std::uint64_t const payload_size) noexcept
+{
+    return Header{ MAGIC,
+                   FORMAT_VERSION,
+                   schema.id,
+                   schema.version,
+                   0,
+                   source_info.size,
+                   source_info.modification_time,
+                   source_hash,
+                   payload_size };
+}
+
+//==============================================================================
+// Only looks at the file system entry : the contents are hashed when there is no other way to tell.
+[[nodiscard]] std::optional<BinaryCache::Source_Info> get_source_info(char const * source_path)
+{
+    if (InputFile::is_stream_path(source_path) || InputFile{ source_path }.preloaded()) {
+        return std::nullopt;
+    }
+
+    std::error_code error{};
+    auto const size{ std::filesystem::file_size(source_path, error) };
+    if (error) {
+        return std::nullopt;
+    }
+    auto const modification_time{ std::filesystem::last_write_time(source_path, error) };
+    if (error) {
+        return std::nullopt;
+    }
+
+    return BinaryCache::Source_Info{ size, static_cast<std::int64_t>(modification_time.time_since_epoch().count()) };
+}
+
+//==============================================================================
+[[nodiscard]] std::uint64_t hash_source(char const * source_path)
+{
+    MappedFile const source{ source_path };
+    return hash_bytes(source.view().cbegin(), source.size());
+}
+
+} // namespace
+
+//==============================================================================
+BinaryCache::BinaryCache(char const * source_path, Cache_Schema const schema)
+    : m_source_path(source_path)
+    , m_cache_path(m_source_path + EXTENSION)
+    , m_schema(schema)
+    , m_source_info(get_source_info(source_path))
+{
+    if (!m_source_info) {
+        return;
+    }
+
+    std::error_code error{};
+    if (!std::filesystem::is_regular_file(m_cache_path, error)) {
+        return;
+    }
+    auto const cache_modification_time{ std::filesystem::last_write_time(m_cache_path, error) };
+    if (error) {
+        return;
+    }
+
+    MappedFile cache_file{ m_cache_path.c_str() };
+    if (cache_file.size() < PAYLOAD_OFFSET) {
+        return;
+    }
+
+    Header header;
+    std::memcpy(&header, cache_file.data(), sizeof(Header));
+    auto expected{ make_header(m_schema, *m_source_info, header.source_hash, cache_file.size() - PAYLOAD_OFFSET) };
+    expected.source_modification_time = header.source_modification_time;
+    if (std::memcmp(&header, &expected, sizeof(Header)) != 0) {
+        // written by another schema, or the size of the source changed
+        return;
+    }
+
+    // A source written in the same clock tick as its cache could have changed without its time stamp moving.
+    auto const is_racy{ header.source_modification_time
+                        >= static_cast<std::int64_t>(cache_modification_time.time_since_epoch().count()) };
+    if (header.source_modification_time != m_source_info->modification_time || is_racy) {
+        // touched or rewritten with the same size : only the contents can tell
+        if (hash_source(source_path) != header.source_hash) {
+            return;
+        }
+    }
+
+    m_cache_file = std::move(cache_file);
+}
+
+//==============================================================================
+BinaryReader BinaryCache::reader() const noexcept(!detail::IS_DEBUG)
+{
+    assert(is_loaded());
+    return BinaryReader{ m_cache_file->view().remove_from_start(PAYLOAD_OFFSET) };
+}
+
+//==============================================================================
+void BinaryCache::store(BinaryWriter const & writer) const
+{
+    if (!m_source_info) {
+        return;
+    }
+
+    auto const payload{ writer.bytes() };
+    auto const header{ make_header(m_schema, *m_source_info, hash_source(m_source_path.c_str()), payload.size()) };
+    std::array<char, PAYLOAD_OFFSET> header_block{};
+    std::memcpy(header_block.data(), &header, sizeof(Header));
+
+    // written aside and renamed, so that concurrent solvers never see a partial cache
+    auto const thread_id{ std::hash<std::thread::id>{}(std::this_thread::get_id()) };
+    auto const temporary_path{ m_cache_path + '.' + std::to_string(thread_id) };
+    {
+        std::ofstream file{ temporary_path, std::ios::binary | std::ios::trunc };
+        file.write(header_block.data(), header_block.size());
+        file.write(payload.cbegin(), static_cast<std::streamsize>(payload.size()));
+        if (!file) {
+            file.close();
+            std::error_code error{};
+            std::filesystem::remove(temporary_path, error);
+            return;
+        }
+    }
+
+    std::error_code error{};
+    std::filesystem::rename(temporary_path, m_cache_path, error);
+    if (error) {
+        std::filesystem::remove(temporary_path, error);
+    }
+}
+
+} // namespace aoc
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "MappedFile.hpp"
+#include "StringView.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace aoc
+{
+//==============================================================================
+// Read-only array that lives inside a cache file.
+template<typename T>
+class Array_View
+{
+    T const * m_data{};
+    std::size_t m_size{};
+
+public:
+    //==============================================================================
+    Array_View() = default;
+    Array_View(T const * data, std::size_t const size) noexcept : m_data(data), m_size(size) {}
+    //==============================================================================
+    [[nodiscard]] T const * begin() const noexcept { return m_data; }
+    [[nodiscard]] T const * end() const noexcept { return m_data + m_size; }
+    [[nodiscard]] T const * cbegin() const noexcept { return m_data; }
+    [[nodiscard]] T const * cend() const noexcept { return m_data + m_size; }
+    //==============================================================================
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] T const & operator[](std::size_t const index) const noexcept(!detail::IS_DEBUG)
+    {
+        assert(index < m_size);
+        return m_data[index];
+    }
+    //==============================================================================
+    [[nodiscard]] std::vector<T> to_vector() const { return std::vector<T>(cbegin(), cend()); }
+};
+
+//==============================================================================
+// Builds the payload of a BinaryCache out of trivially copyable values.
+//
+// Arrays are stored with their size and padded to CACHE_ALIGNMENT, so that BinaryReader can hand them out in place.
+class BinaryWriter
+{
+    std::vector<char> m_bytes{};
+
+public:
+    //==============================================================================
+    static constexpr std::size_t CACHE_ALIGNMENT = 16;
+    //==============================================================================
+    template<typename T>
+    void write(T const & value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be cached.");
+        append(&value, sizeof(T));
+    }
+    //==============================================================================
+    template<typename T>
+    void write_array(T const * data, std::size_t const size)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be cached.");
+        static_assert(alignof(T) <= CACHE_ALIGNMENT, "Over-aligned values can't be cached.");
+        write(std::uint64_t{ size });
+        pad();
+        append(data, size * sizeof(T));
+        pad();
+    }
+    template<typename Container>
+    void write_array(Container const & container)
+    {
+        write_array(container.data(), container.size());
+    }
+    //==============================================================================
+    void write_string(StringView const & string) { write_array(string.cbegin(), string.size()); }
+    //==============================================================================
+    [[nodiscard]] StringView bytes() const noexcept { return StringView{ m_bytes.data(), m_bytes.size() }; }
+
+private:
+    //==============================================================================
+    void append(void const * data, std::size_t const size)
+    {
+        auto const * const bytes{ static_cast<char const *>(data) };
+        m_bytes.insert(m_bytes.end(), bytes, bytes + size);
+    }
+    void pad() { m_bytes.resize((m_bytes.size() + CACHE_ALIGNMENT - 1) / CACHE_ALIGNMENT * CACHE_ALIGNMENT); }
+};
+
+//==============================================================================
+// Reads back, in the same order, what a BinaryWriter wrote. Arrays and strings point into the cache file.
+class BinaryReader
+{
+    char const * m_begin;
+    char const * m_cursor;
+    char const * m_end;
+
+public:
+    //==============================================================================
+    explicit BinaryReader(StringView const & bytes) noexcept
+        : m_begin(bytes.cbegin())
+        , m_cursor(bytes.cbegin())
+        , m_end(bytes.cend())
+    {
+    }
+    //==============================================================================
+    template<typename T>
+    [[nodiscard]] T read() noexcept(!detail::IS_DEBUG)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be cached.");
+        assert(m_cursor + sizeof(T) <= m_end);
+        T result;
+        std::memcpy(&result, m_cursor, sizeof(T));
+        m_cursor += sizeof(T);
+        return result;
+    }
+    //==============================================================================
+    template<typename T>
+    [[nodiscard]] Array_View<T> read_array() noexcept(!detail::IS_DEBUG)
+    {
+        auto const size{ static_cast<std::size_t>(read<std::uint64_t>()) };
+        skip_padding();
+        assert(m_cursor + size * sizeof(T) <= m_end);
+        Array_View<T> const result{ reinterpret_cast<T const *>(m_cursor), size };
+        m_cursor += size * sizeof(T);
+        skip_padding();
+        return result;
+    }
+    //==============================================================================
+    [[nodiscard]] StringView read_string() noexcept(!detail::IS_DEBUG)
+    {
+        auto const characters{ read_array<char>() };
+        return StringView{ characters.cbegin(), characters.size() };
+    }
+
+private:
+    //==============================================================================
+    void skip_padding() noexcept
+    {
+        static constexpr auto ALIGNMENT{ BinaryWriter::CACHE_ALIGNMENT };
+        auto const offset{ static_cast<std::size_t>(m_cursor - m_begin) };
+        m_cursor = m_begin + (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+};
+
+//==============================================================================
+// Identifies what a cache contains. Bump the version whenever the cached layout changes.
+struct Cache_Schema {
+    std::uint32_t id;
+    std::uint32_t version;
+};
+
+//==============================================================================
+// Parsed input stored next to its text source, as "<source>.aocbin".
+//
+// The cache is only used if its schema matches and if the source still has the size and modification time that it had
+// when the cache was written : otherwise, the solver parses the text and calls store(). The source is only hashed when
+// its size matches but its time stamp can't be trusted (touched, or modified right after the cache was written). A
+// valid cache is mapped as a whole and read in place.
+//
+// Streams (see InputFile) and preloaded inputs are never cached. Failing to write the cache is not an error.
+class BinaryCache
+{
+public:
+    //==============================================================================
+    struct Source_Info {
+        std::uint64_t size;
+        std::int64_t modification_time;
+    };
+
+private:
+    std::string m_source_path{};
+    std::string m_cache_path{};
+    Cache_Schema m_schema;
+    std::optional<Source_Info> m_source_info{};
+    std::optional<MappedFile> m_cache_file{};
+
+public:
+    //==============================================================================
+    static constexpr char const * EXTENSION = ".aocbin";
+    //==============================================================================
+    BinaryCache(char const * source_path, Cache_Schema schema);
+    //==============================================================================
+    // Whether a cache was found and is up to date.
+    [[nodiscard]] bool is_loaded() const noexcept { return m_cache_file.has_value(); }
+    // Can only be called when the cache is loaded.
+    [[nodiscard]] BinaryReader reader() const noexcept(!detail::IS_DEBUG);
+    //==============================================================================
+    void store(BinaryWriter const & writer) const;
+};
+
+} // namespace aoc
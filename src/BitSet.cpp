@@ -0,0 +1,216 @@
+#include "BitSet.hpp"
+
+#include "Cpu.hpp"
+
+#if AOC_X86_DISPATCH
+    #include <immintrin.h>
+#endif
+
+namespace aoc
+{
+namespace detail
+{
+namespace
+{
+//==============================================================================
+using combine_words_t = void (*)(std::uint64_t *, std::uint64_t const *, std::size_t) noexcept;
+using count_bits_t = std::size_t (*)(std::uint64_t const *, std::size_t) noexcept;
+using find_nonzero_word_t = std::size_t (*)(std::uint64_t const *, std::size_t) noexcept;
+
+//==============================================================================
+struct Bit_Kernels {
+    combine_words_t and_words;
+    combine_words_t or_words;
+    combine_words_t and_not_words;
+    count_bits_t count_bits;
+    find_nonzero_word_t find_nonzero_word;
+};
+
+//==============================================================================
+void and_words_scalar(std::uint64_t * destination, std::uint64_t const * source, std::size_t const num_words) noexcept
+{
+    for (std::size_t i{}; i < num_words; ++i) {
+        destination[i] &= source[i];
+    }
+}
+void or_words_scalar(std::uint64_t * destination, std::uint64_t const * source, std::size_t const num_words) noexcept
+{
+    for (std::size_t i{}; i < num_words; ++i) {
+        destination[i] |= source[i];
+    }
+}
+void and_not_words_scalar(std::uint64_t * destination,
+                          std::uint64_t const * source,
+                          std::size_t const num_words) noexcept
+{
+    for (std::size_t i{}; i < num_words; ++i) {
+        destination[i] &= ~source[i];
+    }
+}
+
+//==============================================================================
+std::size_t count_bits_scalar(std::uint64_t const * words, std::size_t const num_words) noexcept
+{
+    std::size_t result{};
+    for (std::size_t i{}; i < num_words; ++i) {
+#if defined(__GNUC__) || defined(__clang__)
+        result += static_cast<std::size_t>(__builtin_popcountll(words[i]));
+#else
+        for (auto word{ words[i] }; word != 0; word &= word - 1) {
+            ++result;
+        }
+#endif
+    }
+    return result;
+}
+
+//==============================================================================
+std::size_t find_nonzero_word_scalar(std::uint64_t const * words, std::size_t const num_words) noexcept
+{
+    std::size_t i{};
+    while (i < num_words && words[i] == 0) {
+        ++i;
+    }
+    return i;
+}
+
+#if AOC_X86_DISPATCH
+//==============================================================================
+// Four words per instruction, then the remainder one at a time.
+__attribute__((target("avx2"))) void
+    and_words_avx2(std::uint64_t * destination, std::uint64_t const * source, std::size_t const num_words) noexcept
+{
+    std::size_t i{};
+    for (; i + 4 <= num_words; i += 4) {
+        auto * const destination_chunk{ reinterpret_cast<__m256i *>(destination + i) };
+        auto const source_chunk{ _mm256_loadu_si256(reinterpret_cast<__m256i const *>(source + i)) };
+        _mm256_storeu_si256(destination_chunk, _mm256_and_si256(_mm256_loadu_si256(destination_chunk), source_chunk));
+    }
+    and_words_scalar(destination + i, source + i, num_words - i);
+}
+__attribute__((target("avx2"))) void
+    or_words_avx2(std::uint64_t * destination, std::uint64_t const * source, std::size_t const num_words) noexcept
+{
+    std::size_t i{};
+    for (; i + 4 <= num_words; i += 4) {
+        auto * const destination_chunk{ reinterpret_cast<__m256i *>(destination + i) };
+        auto const source_chunk{ _mm256_loadu_si256(reinterpret_cast<__m256i const *>(source + i)) };
+        _mm256_storeu_si256(destination_chunk, _mm256_or_si256(_mm256_loadu_si256(destination_chunk), source_chunk));
+    }
+    or_words_scalar(destination + i, source + i, num_words - i);
+}
+__attribute__((target("avx2"))) void
+    and_not_words_avx2(std::uint64_t * destination, std::uint64_t const * source, std::size_t const num_words) noexcept
+{
+    std::size_t i{};
+    for (; i + 4 <= num_words; i += 4) {
+        auto * const destination_chunk{ reinterpret_cast<__m256i *>(destination + i) };
+        auto const source_chunk{ _mm256_loadu_si256(reinterpret_cast<__m256i const *>(source + i)) };
+        // andnot negates its first operand
+        _mm256_storeu_si256(destination_chunk,
+                            _mm256_andnot_si256(source_chunk, _mm256_loadu_si256(destination_chunk)));
+    }
+    and_not_words_scalar(destination + i, source + i, num_words - i);
+}
+
+//==============================================================================
+// Population count of each nibble through a pshufb lookup, then summed per 64 bits lane with psadbw (W. Mula).
+__attribute__((target("avx2,popcnt"))) std::size_t count_bits_avx2(std::uint64_t const * words,
+                                                                   std::size_t const num_words) noexcept
+{
+    auto const nibble_counts{ _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                               0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4) };
+    auto const low_nibbles{ _mm256_set1_epi8(0x0F) };
+
+    auto totals{ _mm256_setzero_si256() };
+    std::size_t i{};
+    for (; i + 4 <= num_words; i += 4) {
+        auto const chunk{ _mm256_loadu_si256(reinterpret_cast<__m256i const *>(words + i)) };
+        auto const low{ _mm256_shuffle_epi8(nibble_counts, _mm256_and_si256(chunk, low_nibbles)) };
+        auto const high{ _mm256_shuffle_epi8(nibble_counts,
+                                             _mm256_and_si256(_mm256_srli_epi16(chunk, 4), low_nibbles)) };
+        totals = _mm256_add_epi64(totals, _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256()));
+    }
+    auto result{ static_cast<std::size_t>(_mm256_extract_epi64(totals, 0) + _mm256_extract_epi64(totals, 1)
+                                          + _mm256_extract_epi64(totals, 2) + _mm256_extract_epi64(totals, 3)) };
+    for (; i < num_words; ++i) {
+        result += static_cast<std::size_t>(_mm_popcnt_u64(words[i]));
+    }
+    return result;
+}
+
+//==============================================================================
+__attribute__((target("avx2"))) std::size_t find_nonzero_word_avx2(std::uint64_t const * words,
+                                                                   std::size_t const num_words) noexcept
+{
+    std::size_t i{};
+    for (; i + 4 <= num_words; i += 4) {
+        auto const chunk{ _mm256_loadu_si256(reinterpret_cast<__m256i const *>(words + i)) };
+        if (!_mm256_testz_si256(chunk, chunk)) {
+            break;
+        }
+    }
+    return i + find_nonzero_word_scalar(words + i, num_words - i);
+}
+#endif
+
+//==============================================================================
+Bit_Kernels select_bit_kernels() noexcept
+{
+#if AOC_X86_DISPATCH
+    if (cpu::level() >= cpu::Level::V3) {
+        return Bit_Kernels{ and_words_avx2,
+                            or_words_avx2,
+                            and_not_words_avx2,
+                            count_bits_avx2,
+                            find_nonzero_word_avx2 };
+    }
+#endif
+    return Bit_Kernels{ and_words_scalar,
+                        or_words_scalar,
+                        and_not_words_scalar,
+                        count_bits_scalar,
+                        find_nonzero_word_scalar };
+}
+
+//==============================================================================
+Bit_Kernels const & bit_kernels() noexcept
+{
+    static Bit_Kernels const kernels{ select_bit_kernels() };
+    return kernels;
+}
+
+} // namespace
+
+//==============================================================================
+void and_words(std::uint64_t * destination, std::uint64_t const * source, std::size_t const num_words) noexcept
+{
+    bit_kernels().and_words(destination, source, num_words);
+}
+
+//==============================================================================
+void or_words(std::uint64_t * destination, std::uint64_t const * source, std::size_t const num_words) noexcept
+{
+    bit_kernels().or_words(destination, source, num_words);
+}
+
+//==============================================================================
+void and_not_words(std::uint64_t * destination, std::uint64_t const * source, std::size_t const num_words) noexcept
+{
+    bit_kernels().and_not_words(destination, source, num_words);
+}
+
+//==============================================================================
+std::size_t count_bits(std::uint64_t const * words, std::size_t const num_words) noexcept
+{
+    return bit_kernels().count_bits(words, num_words);
+}
+
+//==============================================================================
+std::size_t find_nonzero_word(std::uint64_t const * words, std::size_t const num_words) noexcept
+{
+    return bit_kernels().find_nonzero_word(words, num_words);
+}
+
+} // namespace detail
+} // namespace aoc
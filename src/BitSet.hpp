@@ -0,0 +1,165 @@
+#pragma once
+
+#include "StringView.hpp"
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace aoc
+{
+namespace detail
+{
+//==============================================================================
+// Operations on arrays of 64 bits words : AVX2 versions when the CPU has it, picked once (see BitSet.cpp).
+void and_words(std::uint64_t * destination, std::uint64_t const * source, std::size_t num_words) noexcept;
+void or_words(std::uint64_t * destination, std::uint64_t const * source, std::size_t num_words) noexcept;
+// destination &= ~source
+void and_not_words(std::uint64_t * destination, std::uint64_t const * source, std::size_t num_words) noexcept;
+[[nodiscard]] std::size_t count_bits(std::uint64_t const * words, std::size_t num_words) noexcept;
+// num_words when they're all zero.
+[[nodiscard]] std::size_t find_nonzero_word(std::uint64_t const * words, std::size_t num_words) noexcept;
+
+} // namespace detail
+
+//==============================================================================
+// A fixed number of bits, chosen at run time, stored in 64 bits words.
+//
+// Meant for the small sets of indexes the solvers keep (candidates, visited nodes) : set operations and counting go
+// through whole words, and the set bits are found with a bit scan instead of testing every index. The bits past size()
+// in the last word are always zero.
+class Bit_Set
+{
+    std::pmr::vector<std::uint64_t> m_words;
+    std::size_t m_size{};
+
+public:
+    //==============================================================================
+    static constexpr std::size_t BITS_PER_WORD = 64;
+    //==============================================================================
+    // All bits cleared.
+    explicit Bit_Set(std::size_t const size,
+                     std::pmr::memory_resource * resource = std::pmr::get_default_resource())
+        : m_words((size + BITS_PER_WORD - 1) / BITS_PER_WORD, resource)
+        , m_size(size)
+    {
+    }
+    //==============================================================================
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+    [[nodiscard]] std::uint64_t const * words() const noexcept { return m_words.data(); }
+    [[nodiscard]] std::size_t num_words() const noexcept { return m_words.size(); }
+    //==============================================================================
+    [[nodiscard]] bool test(std::size_t const index) const noexcept(!detail::IS_DEBUG)
+    {
+        assert(index < m_size);
+        return (m_words[index / BITS_PER_WORD] & bit(index)) != 0;
+    }
+    void set(std::size_t const index) noexcept(!detail::IS_DEBUG)
+    {
+        assert(index < m_size);
+        m_words[index / BITS_PER_WORD] |= bit(index);
+    }
+    void reset(std::size_t const index) noexcept(!detail::IS_DEBUG)
+    {
+        assert(index < m_size);
+        m_words[index / BITS_PER_WORD] &= ~bit(index);
+    }
+    // Sets the bit and returns its previous value.
+    bool test_and_set(std::size_t const index) noexcept(!detail::IS_DEBUG)
+    {
+        assert(index < m_size);
+        auto & word{ m_words[index / BITS_PER_WORD] };
+        auto const was_set{ (word & bit(index)) != 0 };
+        word |= bit(index);
+        return was_set;
+    }
+    void set_all() noexcept
+    {
+        std::fill(m_words.begin(), m_words.end(), ~std::uint64_t{});
+        clear_padding();
+    }
+    void reset_all() noexcept { std::fill(m_words.begin(), m_words.end(), std::uint64_t{}); }
+    //==============================================================================
+    // The other set must have the same size.
+    Bit_Set & operator&=(Bit_Set const & other) noexcept(!detail::IS_DEBUG)
+    {
+        assert(other.m_size == m_size);
+        detail::and_words(m_words.data(), other.m_words.data(), m_words.size());
+        return *this;
+    }
+    Bit_Set & operator|=(Bit_Set const & other) noexcept(!detail::IS_DEBUG)
+    {
+        assert(other.m_size == m_size);
+        detail::or_words(m_words.data(), other.m_words.data(), m_words.size());
+        return *this;
+    }
+    // Clears the bits that are set in other.
+    Bit_Set & and_not(Bit_Set const & other) noexcept(!detail::IS_DEBUG)
+    {
+        assert(other.m_size == m_size);
+        detail::and_not_words(m_words.data(), other.m_words.data(), m_words.size());
+        return *this;
+    }
+    //==============================================================================
+    [[nodiscard]] std::size_t count() const noexcept { return detail::count_bits(m_words.data(), m_words.size()); }
+    [[nodiscard]] bool none() const noexcept { return find_first() == m_size; }
+    [[nodiscard]] bool any() const noexcept { return !none(); }
+    //==============================================================================
+    // Index of the first set bit from index on, or size() when there's none.
+    [[nodiscard]] std::size_t find_next(std::size_t const index) const noexcept
+    {
+        if (index >= m_size) {
+            return m_size;
+        }
+        auto word_index{ index / BITS_PER_WORD };
+        auto const first_word{ m_words[word_index] & (~std::uint64_t{} << (index % BITS_PER_WORD)) };
+        if (first_word != 0) {
+            return word_index * BITS_PER_WORD + detail::count_trailing_zeros(first_word);
+        }
+        ++word_index;
+        word_index += detail::find_nonzero_word(m_words.data() + word_index, m_words.size() - word_index);
+        if (word_index == m_words.size()) {
+            return m_size;
+        }
+        return word_index * BITS_PER_WORD + detail::count_trailing_zeros(m_words[word_index]);
+    }
+    [[nodiscard]] std::size_t find_first() const noexcept { return find_next(0); }
+    //==============================================================================
+    // Calls func(index) for every set bit, in increasing order. func may reset bits of the set, including the current
+    // one, but the bits it sets in the current word are skipped.
+    template<typename Func>
+    void iterate(Func const & func) const
+    {
+        for (std::size_t word_index{}; word_index < m_words.size(); ++word_index) {
+            for (auto word{ m_words[word_index] }; word != 0; word &= word - 1) {
+                auto const index{ word_index * BITS_PER_WORD + detail::count_trailing_zeros(word) };
+                if (test(index)) {
+                    func(index);
+                }
+            }
+        }
+    }
+    //==============================================================================
+    [[nodiscard]] bool operator==(Bit_Set const & other) const noexcept
+    {
+        return m_size == other.m_size && m_words == other.m_words;
+    }
+    [[nodiscard]] bool operator!=(Bit_Set const & other) const noexcept { return !(*this == other); }
+
+private:
+    //==============================================================================
+    [[nodiscard]] static std::uint64_t bit(std::size_t const index) noexcept
+    {
+        return std::uint64_t{ 1 } << (index % BITS_PER_WORD);
+    }
+    //==============================================================================
+    void clear_padding() noexcept
+    {
+        auto const used_bits{ m_size % BITS_PER_WORD };
+        if (used_bits != 0) {
+            m_words.back() &= (std::uint64_t{ 1 } << used_bits) - 1;
+        }
+    }
+};
+
+} // namespace aoc
@@ -0,0 +1,86 @@
+#include "Cpu.hpp"
+
+#include <array>
+#include <cstdlib>
+#include <cstring>
+
+namespace aoc
+{
+namespace cpu
+{
+namespace
+{
+//==============================================================================
+constexpr std::array<char const *, 4> LEVEL_NAMES{ "baseline", "v2", "v3", "v4" };
+
+//==============================================================================
+Features detect_features() noexcept
+{
+    Features result{};
+#if AOC_X86_DISPATCH
+    __builtin_cpu_init();
+    result.ssse3 = __builtin_cpu_supports("ssse3");
+    result.sse4_1 = __builtin_cpu_supports("sse4.1");
+    result.sse4_2 = __builtin_cpu_supports("sse4.2");
+    result.popcnt = __builtin_cpu_supports("popcnt");
+    result.avx = __builtin_cpu_supports("avx");
+    result.avx2 = __builtin_cpu_supports("avx2");
+    result.bmi = __builtin_cpu_supports("bmi");
+    result.bmi2 = __builtin_cpu_supports("bmi2");
+    result.fma = __builtin_cpu_supports("fma");
+    result.avx512f = __builtin_cpu_supports("avx512f");
+    result.avx512bw = __builtin_cpu_supports("avx512bw");
+    result.avx512cd = __builtin_cpu_supports("avx512cd");
+    result.avx512dq = __builtin_cpu_supports("avx512dq");
+    result.avx512vl = __builtin_cpu_supports("avx512vl");
+#endif
+    return result;
+}
+
+//==============================================================================
+Level detect_level() noexcept
+{
+    auto const & f{ features() };
+    auto const has_v2{ f.ssse3 && f.sse4_1 && f.sse4_2 && f.popcnt };
+    auto const has_v3{ has_v2 && f.avx && f.avx2 && f.bmi && f.bmi2 && f.fma };
+    auto const has_v4{ has_v3 && f.avx512f && f.avx512bw && f.avx512cd && f.avx512dq && f.avx512vl };
+    auto const supported{ has_v4 ? Level::V4 : has_v3 ? Level::V3 : has_v2 ? Level::V2 : Level::BASELINE };
+
+    auto const * const cap{ std::getenv("AOC_CPU_LEVEL") };
+    if (cap == nullptr) {
+        return supported;
+    }
+    for (std::size_t i{}; i < LEVEL_NAMES.size(); ++i) {
+        if (std::strcmp(cap, LEVEL_NAMES[i]) == 0) {
+            auto const capped{ static_cast<Level>(i) };
+            return capped < supported ? capped : supported;
+        }
+    }
+    // unknown names don't cap anything
+    return supported;
+}
+
+} // namespace
+
+//==============================================================================
+Features const & features() noexcept
+{
+    static Features const result{ detect_features() };
+    return result;
+}
+
+//==============================================================================
+Level level() noexcept
+{
+    static Level const result{ detect_level() };
+    return result;
+}
+
+//==============================================================================
+char const * level_name(Level const level) noexcept
+{
+    return LEVEL_NAMES[static_cast<std::size_t>(level)];
+}
+
+} // namespace cpu
+} // namespace aoc
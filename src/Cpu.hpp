@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+
+//==============================================================================
+// Whether the x86 kernels are built : their functions are compiled for instruction sets that the rest of the build
+// doesn't target (__attribute__((target(...)))), which needs GCC or Clang. Sources with kernels test it after including
+// this header, and pick them at run time with level().
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #define AOC_X86_DISPATCH 1
+#else
+    #define AOC_X86_DISPATCH 0
+#endif
+
+namespace aoc
+{
+namespace cpu
+{
+//==============================================================================
+// Instruction sets the kernels are written for, oldest first. They follow the x86-64 micro-architecture levels :
+// - BASELINE : SSE2, which every x86-64 CPU has (and the only level of other architectures)
+// - V2 : SSSE3, SSE4.1, SSE4.2 and POPCNT
+// - V3 : V2, AVX, AVX2, BMI1, BMI2 and FMA
+// - V4 : V3 and AVX-512 F, BW, CD, DQ and VL
+enum class Level : std::uint8_t { BASELINE, V2, V3, V4 };
+
+//==============================================================================
+// What the CPU supports, detected once. The checks also make sure that the OS saves the wide registers.
+struct Features {
+    bool ssse3;
+    bool sse4_1;
+    bool sse4_2;
+    bool popcnt;
+    bool avx;
+    bool avx2;
+    bool bmi;
+    bool bmi2;
+    bool fma;
+    bool avx512f;
+    bool avx512bw;
+    bool avx512cd;
+    bool avx512dq;
+    bool avx512vl;
+};
+[[nodiscard]] Features const & features() noexcept;
+
+//==============================================================================
+// The newest level the CPU supports, which the kernel tables are built for. Setting the AOC_CPU_LEVEL environment
+// variable to baseline, v2, v3 or v4 caps it, so that the older kernels can run (and be tested) on newer machines.
+[[nodiscard]] Level level() noexcept;
+[[nodiscard]] char const * level_name(Level level) noexcept;
+
+} // namespace cpu
+} // namespace aoc
@@ -0,0 +1,199 @@
+#pragma once
+
+#include "StringView.hpp"
+#include "hash.hpp"
+#include "shortcuts.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace aoc
+{
+//==============================================================================
+// Open addressing map from integer keys, probed a group of 16 slots at a time (Swiss table style).
+//
+// Each slot has a control byte : EMPTY, or 7 bits of the hash of its key. A probe compares the whole group of control
+// bytes to those 7 bits in one SSE2 instruction, and only the few matching slots have their key compared. Keys and
+// values live in separate arrays, and empty slots hold T{}, so sum_values() adds up a single contiguous array.
+//
+// Elements can't be erased.
+template<typename Key, typename T>
+class Flat_Map
+{
+    static_assert(std::is_integral_v<Key>, "Flat_Map keys are hashed as integers.");
+    //==============================================================================
+    static constexpr std::size_t GROUP_SIZE = 16;
+    static constexpr std::int8_t EMPTY = -128;
+
+    std::pmr::vector<std::int8_t> m_controls;
+    std::pmr::vector<Key> m_keys;
+    std::pmr::vector<T> m_values;
+    std::size_t m_size{};
+
+public:
+    //==============================================================================
+    explicit Flat_Map(std::pmr::memory_resource * resource = std::pmr::get_default_resource()) noexcept
+        : m_controls(resource)
+        , m_keys(resource)
+        , m_values(resource)
+    {
+    }
+    //==============================================================================
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_controls.size(); }
+    //==============================================================================
+    // Room for num_elements without growing. An estimate is enough : overshooting only costs memory.
+    void reserve(std::size_t const num_elements)
+    {
+        auto capacity{ GROUP_SIZE };
+        while (!has_room_for(num_elements, capacity)) {
+            capacity *= 2;
+        }
+        if (capacity > m_controls.size()) {
+            rehash(capacity);
+        }
+    }
+    //==============================================================================
+    // Inserts the element if the key isn't there yet. Returns the value of the key, and whether it was inserted.
+    std::pair<T *, bool> try_emplace(Key const key, T value)
+    {
+        if (!has_room_for(m_size + 1, m_controls.size())) {
+            rehash(std::max(GROUP_SIZE, m_controls.size() * 2));
+        }
+
+        auto const hash{ hash_key(key) };
+        auto const index{ probe(key, hash) };
+        if (m_controls[index] != EMPTY) {
+            return { &m_values[index], false };
+        }
+        m_controls[index] = control_byte(hash);
+        m_keys[index] = key;
+        m_values[index] = std::move(value);
+        ++m_size;
+        return { &m_values[index], true };
+    }
+    // Default-constructs the value of a new key.
+    T & operator[](Key const key) { return *try_emplace(key, T{}).first; }
+    //==============================================================================
+    // nullptr when the key isn't there.
+    [[nodiscard]] T const * find(Key const key) const noexcept
+    {
+        if (m_controls.empty()) {
+            return nullptr;
+        }
+        auto const index{ probe(key, hash_key(key)) };
+        return m_controls[index] != EMPTY ? &m_values[index] : nullptr;
+    }
+    [[nodiscard]] T * find(Key const key) noexcept
+    {
+        return const_cast<T *>(static_cast<Flat_Map const &>(*this).find(key));
+    }
+    [[nodiscard]] bool contains(Key const key) const noexcept { return find(key) != nullptr; }
+    [[nodiscard]] T const & at(Key const key) const noexcept(!detail::IS_DEBUG)
+    {
+        auto const * value{ find(key) };
+        assert(value != nullptr);
+        return *value;
+    }
+    //==============================================================================
+    // Calls func(key, value) for every element, in no particular order.
+    template<typename Func>
+    void iterate(Func const & func) const
+    {
+        for (std::size_t i{}; i < m_controls.size(); ++i) {
+            if (m_controls[i] != EMPTY) {
+                func(m_keys[i], m_values[i]);
+            }
+        }
+    }
+    //==============================================================================
+    // Sum of every value, empty slots included since they hold T{}.
+    [[nodiscard]] T sum_values() const noexcept { return aoc::reduce(m_values, T{}, std::plus()); }
+
+private:
+    //==============================================================================
+    // Load factor of at most 7/8.
+    [[nodiscard]] static bool has_room_for(std::size_t const num_elements, std::size_t const capacity) noexcept
+    {
+        return num_elements * 8 <= capacity * 7;
+    }
+    //==============================================================================
+    [[nodiscard]] static std::uint64_t hash_key(Key const key) noexcept
+    {
+        return detail::mix(static_cast<std::uint64_t>(key) ^ detail::HASH_SECRET[0], detail::HASH_SECRET[1]);
+    }
+    // The low 7 bits go in the control byte, the others pick the first group to probe.
+    [[nodiscard]] static std::int8_t control_byte(std::uint64_t const hash) noexcept
+    {
+        return static_cast<std::int8_t>(hash & 0x7F);
+    }
+    //==============================================================================
+    // Bit i is set when group[i] == control.
+    [[nodiscard]] static std::uint32_t match(std::int8_t const * group, std::int8_t const control) noexcept
+    {
+#if defined(__SSE2__)
+        auto const controls{ _mm_loadu_si128(reinterpret_cast<__m128i const *>(group)) };
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(controls, _mm_set1_epi8(control))));
+#else
+        std::uint32_t result{};
+        for (std::size_t i{}; i < GROUP_SIZE; ++i) {
+            result |= std::uint32_t{ group[i] == control } << i;
+        }
+        return result;
+#endif
+    }
+    //==============================================================================
+    // Index of the key's slot, or of the empty slot where it would go. Groups are visited in triangular order, which
+    // goes through all of them since their number is a power of 2. No element is ever erased, so a group with an empty
+    // slot ends the search.
+    [[nodiscard]] std::size_t probe(Key const key, std::uint64_t const hash) const noexcept
+    {
+        auto const group_mask{ m_controls.size() / GROUP_SIZE - 1 };
+        auto const control{ control_byte(hash) };
+        auto group{ static_cast<std::size_t>(hash >> 7) & group_mask };
+        for (std::size_t stride{ 1 };; group = (group + stride++) & group_mask) {
+            auto const first_slot{ group * GROUP_SIZE };
+            auto const * const controls{ m_controls.data() + first_slot };
+            for (auto matches{ match(controls, control) }; matches != 0; matches &= matches - 1) {
+                auto const index{ first_slot + detail::count_trailing_zeros(matches) };
+                if (m_keys[index] == key) {
+                    return index;
+                }
+            }
+            auto const empty_slots{ match(controls, EMPTY) };
+            if (empty_slots != 0) {
+                return first_slot + detail::count_trailing_zeros(empty_slots);
+            }
+        }
+    }
+    //==============================================================================
+    void rehash(std::size_t const capacity)
+    {
+        assert(capacity % GROUP_SIZE == 0 && (capacity & (capacity - 1)) == 0);
+        auto const allocator{ m_controls.get_allocator() };
+        auto const old_controls{ std::exchange(m_controls, std::pmr::vector<std::int8_t>(capacity, EMPTY, allocator)) };
+        auto const old_keys{ std::exchange(m_keys, std::pmr::vector<Key>(capacity, allocator)) };
+        auto old_values{ std::exchange(m_values, std::pmr::vector<T>(capacity, allocator)) };
+        for (std::size_t i{}; i < old_controls.size(); ++i) {
+            if (old_controls[i] == EMPTY) {
+                continue;
+            }
+            // keys are unique, so the first empty slot of the probe sequence is the right one
+            auto const index{ probe(old_keys[i], hash_key(old_keys[i])) };
+            m_controls[index] = old_controls[i];
+            m_keys[index] = old_keys[i];
+            m_values[index] = std::move(old_values[i]);
+        }
+    }
+};
+
+} // namespace aoc
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "StringView.hpp"
+#include "hash.hpp"
+
+#include <memory_resource>
+#include <vector>
+
+namespace aoc
+{
+//==============================================================================
+// Open addressing map from StringView keys, with linear probing.
+//
+// Slots are stored inline in a single array and keep the full hash of their key. A probe compares hashes first and
+// only reads the key's characters when they're equal, so most lookups touch one cache line of the table and one of the
+// key. Growing reuses the stored hashes instead of hashing every key again.
+//
+// Keys aren't copied : the strings they point to must outlive the map. Elements can't be erased. The table is allocated
+// from the memory resource given at construction (see SolverArena).
+template<typename T>
+class FlatStringMap
+{
+    //==============================================================================
+    struct Slot {
+        std::uint64_t hash; // 0 : empty
+        StringView key;
+        T value;
+    };
+    //==============================================================================
+    static constexpr std::size_t MIN_CAPACITY = 16;
+
+    std::pmr::vector<Slot> m_slots;
+    std::size_t m_size{};
+
+public:
+    //==============================================================================
+    explicit FlatStringMap(std::pmr::memory_resource * resource = std::pmr::get_default_resource()) noexcept
+        : m_slots(resource)
+    {
+    }
+    //==============================================================================
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+    //==============================================================================
+    // Room for num_elements without growing.
+    void reserve(std::size_t const num_elements)
+    {
+        auto capacity{ MIN_CAPACITY };
+        while (!has_room_for(num_elements, capacity)) {
+            capacity *= 2;
+        }
+        if (capacity > m_slots.size()) {
+            rehash(capacity);
+        }
+    }
+    //==============================================================================
+    // Inserts the element if the key isn't there yet. Returns the value of the key, and whether it was inserted.
+    std::pair<T *, bool> try_emplace(StringView const & key, T value)
+    {
+        if (!has_room_for(m_size + 1, m_slots.size())) {
+            rehash(std::max(MIN_CAPACITY, m_slots.size() * 2));
+        }
+
+        auto const hash{ hash_key(key) };
+        auto & slot{ m_slots[probe(key, hash)] };
+        if (slot.hash != 0) {
+            return { &slot.value, false };
+        }
+        slot = Slot{ hash, key, std::move(value) };
+        ++m_size;
+        return { &slot.value, true };
+    }
+    //==============================================================================
+    // nullptr when the key isn't there.
+    [[nodiscard]] T const * find(StringView const & key) const noexcept
+    {
+        if (m_slots.empty()) {
+            return nullptr;
+        }
+        auto const & slot{ m_slots[probe(key, hash_key(key))] };
+        return slot.hash != 0 ? &slot.value : nullptr;
+    }
+    [[nodiscard]] T * find(StringView const & key) noexcept
+    {
+        return const_cast<T *>(static_cast<FlatStringMap const &>(*this).find(key));
+    }
+    [[nodiscard]] bool contains(StringView const & key) const noexcept { return find(key) != nullptr; }
+    [[nodiscard]] T const & at(StringView const & key) const noexcept(!detail::IS_DEBUG)
+    {
+        auto const * value{ find(key) };
+        assert(value != nullptr);
+        return *value;
+    }
+    //==============================================================================
+    // Calls func(key, value) for every element, in no particular order.
+    template<typename Func>
+    void iterate(Func const & func) const
+    {
+        for (auto const & slot : m_slots) {
+            if (slot.hash != 0) {
+                func(slot.key, slot.value);
+            }
+        }
+    }
+
+private:
+    //==============================================================================
+    // Load factor of at most 3/4.
+    [[nodiscard]] static bool has_room_for(std::size_t const num_elements, std::size_t const capacity) noexcept
+    {
+        return num_elements * 4 <= capacity * 3;
+    }
+    //==============================================================================
+    [[nodiscard]] static std::uint64_t hash_key(StringView const & key) noexcept
+    {
+        auto const hash{ hash_bytes(key.cbegin(), key.size()) };
+        return hash == 0 ? 1 : hash;
+    }
+    //==============================================================================
+    // Index of the key's slot, or of the empty slot where it would go.
+    [[nodiscard]] std::size_t probe(StringView const & key, std::uint64_t const hash) const noexcept
+    {
+        auto const mask{ m_slots.size() - 1 };
+        for (auto index{ static_cast<std::size_t>(hash) & mask };; index = (index + 1) & mask) {
+            auto const & slot{ m_slots[index] };
+            if (slot.hash == 0 || (slot.hash == hash && slot.key == key)) {
+                return index;
+            }
+        }
+    }
+    //==============================================================================
+    void rehash(std::size_t const capacity)
+    {
+        assert((capacity & (capacity - 1)) == 0);
+        auto old_slots{ std::exchange(m_slots, std::pmr::vector<Slot>(capacity, m_slots.get_allocator())) };
+        auto const mask{ capacity - 1 };
+        for (auto & old_slot : old_slots) {
+            if (old_slot.hash == 0) {
+                continue;
+            }
+            auto index{ static_cast<std::size_t>(old_slot.hash) & mask };
+            while (m_slots[index].hash != 0) {
+                index = (index + 1) & mask;
+            }
+            m_slots[index] = std::move(old_slot);
+        }
+    }
+};
+
+} // namespace aoc
@@ -0,0 +1,68 @@
+#include "GridKernels.hpp"
+
+#include "Cpu.hpp"
+
+namespace aoc
+{
+namespace detail
+{
+//==============================================================================
+// The copies of GridKernelsTarget.cpp. Only the baseline one is built when the compiler can't target the other levels.
+namespace baseline
+{
+void add_cells(std::uint32_t * destination, std::uint32_t const * source, std::size_t size) noexcept;
+} // namespace baseline
+#if AOC_KERNEL_TARGETS
+namespace v3
+{
+void add_cells(std::uint32_t * destination, std::uint32_t const * source, std::size_t size) noexcept;
+} // namespace v3
+namespace v4
+{
+void add_cells(std::uint32_t * destination, std::uint32_t const * source, std::size_t size) noexcept;
+} // namespace v4
+#endif
+
+namespace
+{
+//==============================================================================
+using add_cells_t = void (*)(std::uint32_t *, std::uint32_t const *, std::size_t) noexcept;
+
+//==============================================================================
+struct Grid_Kernels {
+    add_cells_t add_cells;
+};
+
+//==============================================================================
+// V2 adds nothing to these loops, so it runs the baseline copy.
+Grid_Kernels select_grid_kernels() noexcept
+{
+#if AOC_KERNEL_TARGETS
+    auto const level{ cpu::level() };
+    if (level >= cpu::Level::V4) {
+        return Grid_Kernels{ v4::add_cells };
+    }
+    if (level >= cpu::Level::V3) {
+        return Grid_Kernels{ v3::add_cells };
+    }
+#endif
+    return Grid_Kernels{ baseline::add_cells };
+}
+
+//==============================================================================
+Grid_Kernels const & grid_kernels() noexcept
+{
+    static Grid_Kernels const kernels{ select_grid_kernels() };
+    return kernels;
+}
+
+} // namespace
+
+//==============================================================================
+void add_cells(std::uint32_t * destination, std::uint32_t const * source, std::size_t const size) noexcept
+{
+    grid_kernels().add_cells(destination, source, size);
+}
+
+} // namespace detail
+} // namespace aoc
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace aoc
+{
+namespace detail
+{
+//==============================================================================
+// Element-wise operations on grids of cells, stored as flat arrays. Plain loops compiled once per cpu::Level (see
+// GridKernelsTarget.cpp), the best one the CPU supports picked once (see GridKernels.cpp).
+//
+// destination[i] += source[i]. The arrays must not overlap.
+void add_cells(std::uint32_t * destination, std::uint32_t const * source, std::size_t size) noexcept;
+
+} // namespace detail
+} // namespace aoc
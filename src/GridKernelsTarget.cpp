@@ -0,0 +1,33 @@
+// Compiled once per cpu::Level, with the matching -march and AOC_KERNEL_TARGET set to the name of the level (see
+// aoc_add_kernel_targets() in CMakeLists.txt). The loops are left for the compiler to vectorize with the widest
+// registers of each level.
+//
+// Nothing here may come from a header with inline functions or templates : the linker keeps a single copy of those,
+// which could be one compiled for a newer level than the CPU running it.
+
+#include <cstddef>
+#include <cstdint>
+
+#ifndef AOC_KERNEL_TARGET
+    #error "AOC_KERNEL_TARGET must name the level this file is compiled for."
+#endif
+
+namespace aoc
+{
+namespace detail
+{
+namespace AOC_KERNEL_TARGET
+{
+//==============================================================================
+void add_cells(std::uint32_t * __restrict destination,
+               std::uint32_t const * __restrict source,
+               std::size_t const size) noexcept
+{
+    for (std::size_t i{}; i < size; ++i) {
+        destination[i] += source[i];
+    }
+}
+
+} // namespace AOC_KERNEL_TARGET
+} // namespace detail
+} // namespace aoc
@@ -0,0 +1,74 @@
+#include "HugePageAllocator.hpp"
+
+#include <cstdint>
+
+#if defined(__linux__)
+    #include <sys/mman.h>
+#else
+    #include <cstring>
+#endif
+
+namespace aoc
+{
+namespace detail
+{
+namespace
+{
+//==============================================================================
+[[nodiscard]] std::size_t round_to_huge_pages(std::size_t const size) noexcept
+{
+    return (size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+}
+
+} // namespace
+
+//==============================================================================
+void * allocate_huge_pages(std::size_t const size) noexcept
+{
+    auto const mapping_size{ round_to_huge_pages(size) };
+#if defined(__linux__)
+    static constexpr int PROTECTION = PROT_READ | PROT_WRITE;
+    static constexpr int FLAGS = MAP_PRIVATE | MAP_ANONYMOUS;
+
+    // private hugetlb mappings reserve their pages right away, so this fails here rather than on first touch
+    auto * const explicit_pages{ ::mmap(nullptr, mapping_size, PROTECTION, FLAGS | MAP_HUGETLB, -1, 0) };
+    if (explicit_pages != MAP_FAILED) {
+        return explicit_pages;
+    }
+
+    // transparent huge pages only back the 2 MB aligned parts of a mapping : map one more page and trim both ends
+    auto * const mapping{ static_cast<char *>(
+        ::mmap(nullptr, mapping_size + HUGE_PAGE_SIZE, PROTECTION, FLAGS, -1, 0)) };
+    if (mapping == MAP_FAILED) {
+        return nullptr;
+    }
+    auto const misalignment{ reinterpret_cast<std::uintptr_t>(mapping) % HUGE_PAGE_SIZE };
+    auto const head_size{ misalignment == 0 ? 0 : HUGE_PAGE_SIZE - misalignment };
+    auto * const address{ mapping + head_size };
+    if (head_size != 0) {
+        ::munmap(mapping, head_size);
+    }
+    ::munmap(address + mapping_size, HUGE_PAGE_SIZE - head_size);
+    ::madvise(address, mapping_size, MADV_HUGEPAGE);
+    return address;
+#else
+    auto * const address{ ::operator new(mapping_size, std::align_val_t{ HUGE_PAGE_SIZE }, std::nothrow) };
+    if (address != nullptr) {
+        std::memset(address, 0, mapping_size);
+    }
+    return address;
+#endif
+}
+
+//==============================================================================
+void deallocate_huge_pages(void * const address, std::size_t const size) noexcept
+{
+#if defined(__linux__)
+    ::munmap(address, round_to_huge_pages(size));
+#else
+    ::operator delete(address, std::align_val_t{ HUGE_PAGE_SIZE });
+#endif
+}
+
+} // namespace detail
+} // namespace aoc
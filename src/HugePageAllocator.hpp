@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+namespace aoc
+{
+namespace detail
+{
+//==============================================================================
+static constexpr std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+//==============================================================================
+// Zeroed, HUGE_PAGE_SIZE aligned memory, rounded up to whole huge pages. nullptr when the system refuses (see
+// HugePageAllocator.cpp).
+[[nodiscard]] void * allocate_huge_pages(std::size_t size) noexcept;
+// size is the one given to allocate_huge_pages().
+void deallocate_huge_pages(void * address, std::size_t size) noexcept;
+
+} // namespace detail
+
+//==============================================================================
+// Allocator for large tables accessed all over the place : the blocks of at least HUGE_PAGE_SIZE bytes are mapped on
+// 2 MB pages, so a single TLB entry covers what takes 512 with 4 KB pages.
+//
+// Explicit huge pages (MAP_HUGETLB) are used when the system has some reserved. Otherwise the block is aligned on
+// 2 MB and madvise(MADV_HUGEPAGE) asks for transparent huge pages, which the kernel may or may not grant : the memory
+// works the same either way. Smaller blocks come from std::allocator, and on systems other than Linux, the large ones
+// are only aligned.
+template<typename T>
+class Huge_Page_Allocator
+{
+public:
+    //==============================================================================
+    using value_type = T;
+    //==============================================================================
+    Huge_Page_Allocator() noexcept = default;
+    template<typename U>
+    Huge_Page_Allocator(Huge_Page_Allocator<U> const &) noexcept
+    {
+    }
+    //==============================================================================
+    [[nodiscard]] T * allocate(std::size_t const n)
+    {
+        if (!is_huge(n)) {
+            return std::allocator<T>{}.allocate(n);
+        }
+        auto * const address{ detail::allocate_huge_pages(n * sizeof(T)) };
+        if (address == nullptr) {
+            throw std::bad_alloc{};
+        }
+        return static_cast<T *>(address);
+    }
+    void deallocate(T * const address, std::size_t const n) noexcept
+    {
+        if (!is_huge(n)) {
+            std::allocator<T>{}.deallocate(address, n);
+            return;
+        }
+        detail::deallocate_huge_pages(address, n * sizeof(T));
+    }
+    //==============================================================================
+    template<typename U>
+    [[nodiscard]] bool operator==(Huge_Page_Allocator<U> const &) const noexcept
+    {
+        return true;
+    }
+    template<typename U>
+    [[nodiscard]] bool operator!=(Huge_Page_Allocator<U> const &) const noexcept
+    {
+        return false;
+    }
+
+private:
+    //==============================================================================
+    [[nodiscard]] static bool is_huge(std::size_t const n) noexcept { return n >= detail::HUGE_PAGE_SIZE / sizeof(T); }
+};
+
+} // namespace aoc
@@ -0,0 +1,189 @@
+#include "InputFile.hpp"
+
+#include "narrow.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <charconv>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#if defined(_WIN32)
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+namespace aoc
+{
+namespace
+{
+//==============================================================================
+constexpr std::size_t READ_CHUNK_SIZE = 64 * 1024;
+
+//==============================================================================
+thread_local PreloadedInput const * current_preload{};
+
+//==============================================================================
+[[nodiscard]] bool starts_with(char const * string, char const * prefix) noexcept
+{
+    return std::strncmp(string, prefix, std::strlen(prefix)) == 0;
+}
+
+//==============================================================================
+int open_read_only(char const * path) noexcept
+{
+#if defined(_WIN32)
+    return ::_open(path, _O_RDONLY | _O_BINARY);
+#else
+    auto const fd{ ::open(path, O_RDONLY | O_CLOEXEC) };
+    #if defined(POSIX_FADV_SEQUENTIAL)
+    if (fd >= 0) {
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+    #endif
+    return fd;
+#endif
+}
+
+} // namespace
+
+//==============================================================================
+InputFile::InputFile(char const * path)
+{
+    if (current_preload != nullptr && std::strcmp(path, current_preload->m_path) == 0) {
+        m_is_preloaded = true;
+        m_preloaded_leftover = current_preload->m_contents;
+    } else if (std::strcmp(path, STANDARD_INPUT) == 0) {
+#if defined(_WIN32)
+        m_fd = ::_fileno(stdin);
+        ::_setmode(m_fd, _O_BINARY);
+#else
+        m_fd = STDIN_FILENO;
+#endif
+    } else if (starts_with(path, FILE_DESCRIPTOR_PREFIX)) {
+        auto const * const number_begin{ path + std::strlen(FILE_DESCRIPTOR_PREFIX) };
+        auto const * const number_end{ number_begin + std::strlen(number_begin) };
+        [[maybe_unused]] auto const error{ std::from_chars(number_begin, number_end, m_fd) };
+        assert(error.ec == std::errc() && error.ptr == number_end);
+    } else {
+        m_fd = open_read_only(path);
+        m_is_owned = true;
+    }
+    assert(is_open());
+}
+
+//==============================================================================
+InputFile::~InputFile()
+{
+    if (m_is_owned && is_open()) {
+#if defined(_WIN32)
+        ::_close(m_fd);
+#else
+        ::close(m_fd);
+#endif
+    }
+}
+
+//==============================================================================
+bool InputFile::is_stream_path(char const * path) noexcept
+{
+    return std::strcmp(path, STANDARD_INPUT) == 0 || starts_with(path, FILE_DESCRIPTOR_PREFIX);
+}
+
+//==============================================================================
+std::optional<StringView> InputFile::preloaded() const noexcept
+{
+    if (!m_is_preloaded) {
+        return std::nullopt;
+    }
+    return m_preloaded_leftover;
+}
+
+//==============================================================================
+std::optional<std::size_t> InputFile::regular_file_size() const noexcept
+{
+    if (m_fd < 0) {
+        return std::nullopt;
+    }
+#if defined(_WIN32)
+    struct _stat64 file_status {
+    };
+    if (::_fstat64(m_fd, &file_status) != 0 || (file_status.st_mode & _S_IFREG) == 0) {
+        return std::nullopt;
+    }
+#else
+    struct stat file_status {
+    };
+    if (::fstat(m_fd, &file_status) != 0 || !S_ISREG(file_status.st_mode)) {
+        return std::nullopt;
+    }
+#endif
+    return static_cast<std::size_t>(file_status.st_size);
+}
+
+//==============================================================================
+std::size_t InputFile::read_some(char * destination, std::size_t const size)
+{
+    if (m_is_preloaded) {
+        auto const bytes_read{ std::min(size, m_preloaded_leftover.size()) };
+        std::memcpy(destination, m_preloaded_leftover.cbegin(), bytes_read);
+        m_preloaded_leftover = m_preloaded_leftover.remove_from_start(bytes_read);
+        return bytes_read;
+    }
+    if (!is_open()) {
+        return 0;
+    }
+    while (true) {
+#if defined(_WIN32)
+        auto const clamped_size{ static_cast<unsigned>(std::min<std::size_t>(size, INT_MAX)) };
+        auto const bytes_read{ ::_read(m_fd, destination, clamped_size) };
+#else
+        auto const bytes_read{ ::read(m_fd, destination, size) };
+#endif
+        if (bytes_read < 0 && errno == EINTR) {
+            continue;
+        }
+        assert(bytes_read >= 0);
+        return bytes_read < 0 ? 0 : static_cast<std::size_t>(bytes_read);
+    }
+}
+
+//==============================================================================
+void InputFile::read_all(std::vector<char> & buffer)
+{
+    auto size{ buffer.size() };
+    while (true) {
+        if (buffer.size() - size < READ_CHUNK_SIZE) {
+            buffer.resize(std::max(buffer.size() * 2, size + READ_CHUNK_SIZE));
+        }
+        auto const bytes_read{ read_some(buffer.data() + size, buffer.size() - size) };
+        if (bytes_read == 0) {
+            break;
+        }
+        size += bytes_read;
+    }
+    buffer.resize(size);
+}
+
+//==============================================================================
+PreloadedInput::PreloadedInput(char const * path, StringView const & contents) noexcept(!detail::IS_DEBUG)
+    : m_path(path)
+    , m_contents(contents)
+{
+    assert(current_preload == nullptr);
+    current_preload = this;
+}
+
+//==============================================================================
+PreloadedInput::~PreloadedInput()
+{
+    assert(current_preload == this);
+    current_preload = nullptr;
+}
+
+} // namespace aoc
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "StringView.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace aoc
+{
+//==============================================================================
+// Read-only file descriptor for a solver input.
+//
+// Besides regular paths, two special forms are understood :
+//  - "-" reads the standard input;
+//  - "fd:<n>" reads an already open file descriptor.
+// Those descriptors are borrowed and are not closed.
+//
+// A path that is covered by a PreloadedInput on the current thread is served from memory instead.
+class InputFile
+{
+    int m_fd{ -1 };
+    bool m_is_owned{};
+    bool m_is_preloaded{};
+    StringView m_preloaded_leftover{};
+
+public:
+    //==============================================================================
+    static constexpr char const * STANDARD_INPUT = "-";
+    static constexpr char const * FILE_DESCRIPTOR_PREFIX = "fd:";
+    //==============================================================================
+    explicit InputFile(char const * path);
+    ~InputFile();
+    //==============================================================================
+    InputFile(InputFile const &) = delete;
+    InputFile(InputFile &&) = delete;
+    InputFile & operator=(InputFile const &) = delete;
+    InputFile & operator=(InputFile &&) = delete;
+    //==============================================================================
+    [[nodiscard]] static bool is_stream_path(char const * path) noexcept;
+    //==============================================================================
+    [[nodiscard]] bool is_open() const noexcept { return m_fd >= 0 || m_is_preloaded; }
+    [[nodiscard]] int fd() const noexcept { return m_fd; }
+    // The bytes that haven't been read yet, when the input is preloaded.
+    [[nodiscard]] std::optional<StringView> preloaded() const noexcept;
+    // Size of the file when it is a regular file, nothing for pipes, terminals and devices.
+    [[nodiscard]] std::optional<std::size_t> regular_file_size() const noexcept;
+    //==============================================================================
+    // Reads at most size bytes, retrying on interruptions. Returns 0 at the end of the input.
+    [[nodiscard]] std::size_t read_some(char * destination, std::size_t size);
+    // Appends everything left in the input to buffer.
+    void read_all(std::vector<char> & buffer);
+};
+
+//==============================================================================
+// While alive, opening path on this thread reads contents instead of touching the file system.
+//
+// This lets loaders that already have the bytes (see BatchLoader) run the regular path-based solvers. contents must
+// outlive the scope, and scopes can't be nested.
+class PreloadedInput
+{
+    friend class InputFile;
+
+    char const * m_path;
+    StringView m_contents;
+
+public:
+    //==============================================================================
+    PreloadedInput(char const * path, StringView const & contents) noexcept(!detail::IS_DEBUG);
+    ~PreloadedInput();
+    //==============================================================================
+    PreloadedInput(PreloadedInput const &) = delete;
+    PreloadedInput(PreloadedInput &&) = delete;
+    PreloadedInput & operator=(PreloadedInput const &) = delete;
+    PreloadedInput & operator=(PreloadedInput &&) = delete;
+};
+
+} // namespace aoc
@@ -0,0 +1,94 @@
+#include "LineStream.hpp"
+
+#include <cstring>
+
+namespace aoc
+{
+//==============================================================================
+LineStream::LineStream(char const * path, std::size_t const chunk_size) : m_file(path)
+{
+    assert(chunk_size > 0);
+    m_buffer.resize(chunk_size);
+    m_end_of_file = !m_file.is_open();
+}
+
+//==============================================================================
+bool LineStream::next(StringView & out_line)
+{
+    if (!m_has_pending && !refill()) {
+        return false;
+    }
+
+    auto const * const line_feed{ m_pending.find('\n') };
+    out_line = StringView{ m_pending.cbegin(), line_feed };
+    if (line_feed == m_pending.cend()) {
+        m_has_pending = false;
+    } else {
+        m_pending = StringView{ std::next(line_feed), m_pending.cend() };
+    }
+    return true;
+}
+
+//==============================================================================
+bool LineStream::next_chunk(StringView & out_lines)
+{
+    if (!m_has_pending && !refill()) {
+        return false;
+    }
+
+    out_lines = m_pending;
+    m_has_pending = false;
+    return true;
+}
+
+//==============================================================================
+bool LineStream::refill()
+{
+    // keep the partial line that was cut by the previous read
+    auto const leftover_size{ m_data_end - m_leftover_begin };
+    std::memmove(m_buffer.data(), m_buffer.data() + m_leftover_begin, leftover_size);
+    m_data_end = leftover_size;
+    m_leftover_begin = 0;
+
+    while (true) {
+        while (!m_end_of_file && m_data_end < m_buffer.size()) {
+            auto const bytes_read{ m_file.read_some(m_buffer.data() + m_data_end, m_buffer.size() - m_data_end) };
+            if (bytes_read == 0) {
+                m_end_of_file = true;
+                break;
+            }
+            m_data_end += bytes_read;
+        }
+
+        auto const * const data_begin{ m_buffer.data() };
+        auto const * const data_end{ data_begin + m_data_end };
+
+        if (m_end_of_file) {
+            if (m_data_end == 0) {
+                return false;
+            }
+            // nothing left to read : the rest is the last chunk, with or without a final line feed
+            auto const has_final_line_feed{ *std::prev(data_end) == '\n' };
+            m_pending = StringView{ data_begin, has_final_line_feed ? std::prev(data_end) : data_end };
+            m_leftover_begin = m_data_end;
+            m_has_pending = true;
+            return true;
+        }
+
+        auto const last_line_feed{ std::find(std::make_reverse_iterator(data_end),
+                                             std::make_reverse_iterator(data_begin),
+                                             '\n') };
+        if (last_line_feed.base() != data_begin) {
+            // last_line_feed.base() points right after the line feed
+            m_pending = StringView{ data_begin, std::prev(last_line_feed.base()) };
+            m_leftover_begin = aoc::narrow<std::size_t>(last_line_feed.base() - data_begin);
+            m_has_pending = true;
+            return true;
+        }
+
+        // a single line doesn't fit in the buffer
+        m_buffer.resize(m_buffer.size() * 2);
+    }
+}
+
+} // namespace aoc
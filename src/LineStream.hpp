@@ -0,0 +1,132 @@
+#pragma once
+
+#include "InputFile.hpp"
+#include "StringView.hpp"
+#include "StructuralIndex.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace aoc
+{
+//==============================================================================
+// Reads a line-oriented input in fixed-size chunks instead of loading it whole.
+//
+// Lines are handed out as StringViews that never straddle a chunk boundary : a partial line at the end of a chunk is
+// moved to the front of the buffer before the next read. Memory stays bounded by the chunk size (the buffer only grows
+// when a single line doesn't fit in it). A view is only valid until the next call that advances the stream.
+//
+// A trailing line feed at the end of the input doesn't produce an extra empty line. Since nothing is ever mapped, this
+// also works on the standard input and pipes (see InputFile for the accepted paths).
+class LineStream
+{
+    InputFile m_file;
+    std::vector<char> m_buffer{};
+    std::size_t m_data_end{};
+    std::size_t m_leftover_begin{};
+    StringView m_pending{};
+    bool m_has_pending{};
+    bool m_end_of_file{};
+
+public:
+    //==============================================================================
+    static constexpr std::size_t DEFAULT_CHUNK_SIZE = 1024 * 1024;
+    //==============================================================================
+    explicit LineStream(char const * path, std::size_t chunk_size = DEFAULT_CHUNK_SIZE);
+    ~LineStream() = default;
+    //==============================================================================
+    LineStream(LineStream const &) = delete;
+    LineStream(LineStream &&) = delete;
+    LineStream & operator=(LineStream const &) = delete;
+    LineStream & operator=(LineStream &&) = delete;
+    //==============================================================================
+    // Next line, without its line feed.
+    [[nodiscard]] bool next(StringView & out_line);
+    // Every line left in the current chunk, joined by line feeds (without the last one).
+    [[nodiscard]] bool next_chunk(StringView & out_lines);
+    // Whether the input is known to be over : the next call to next() or next_chunk() returns false. Once the end of
+    // the file is reached, everything left is handed out as a single chunk.
+    [[nodiscard]] bool is_exhausted() const noexcept
+    {
+        return !m_has_pending && m_end_of_file && m_leftover_begin == m_data_end;
+    }
+    //==============================================================================
+    template<typename Func>
+    void iterate(Func const & func)
+    {
+        StringView chunk;
+        while (next_chunk(chunk)) {
+            chunk.iterate(func, '\n');
+        }
+    }
+    //==============================================================================
+    template<typename Func>
+    auto iterate_transform(Func const & func)
+    {
+        using value_type = decltype(func(StringView{}));
+        std::vector<value_type> result{};
+
+        iterate([&](StringView const & line) { result.push_back(func(line)); });
+
+        return result;
+    }
+    //==============================================================================
+    template<typename T>
+    [[nodiscard]] std::vector<T> parse_list()
+    {
+        return iterate_transform([](StringView const & line) { return line.parse<T>(); });
+    }
+    //==============================================================================
+    template<typename T>
+    [[nodiscard]] std::vector<T> parse_list_and_sort()
+    {
+        auto result{ parse_list<T>() };
+        aoc::sort(result);
+        return result;
+    }
+
+    //==============================================================================
+    // Each chunk is indexed, then its lines are split between threads by StructuralIndex::transform_lines_parallel().
+    template<typename Func>
+    auto iterate_transform_parallel(Func const & func, std::size_t const max_threads = detail::hardware_threads())
+    {
+        using value_type = decltype(func(StringView{}));
+        std::vector<value_type> result{};
+
+        StringView chunk;
+        while (next_chunk(chunk)) {
+            StructuralIndex const index{ chunk };
+            auto chunk_result{ index.transform_lines_parallel(func, max_threads) };
+            if (result.empty()) {
+                result = std::move(chunk_result);
+            } else {
+                result.insert(result.end(),
+                              std::make_move_iterator(chunk_result.begin()),
+                              std::make_move_iterator(chunk_result.end()));
+            }
+        }
+
+        return result;
+    }
+    //==============================================================================
+    template<typename T>
+    [[nodiscard]] std::vector<T> parse_list_parallel(std::size_t const max_threads = detail::hardware_threads())
+    {
+        return iterate_transform_parallel([](StringView const & line) { return line.parse<T>(); }, max_threads);
+    }
+    //==============================================================================
+    template<typename T>
+    [[nodiscard]] std::vector<T> parse_list_and_sort_parallel()
+    {
+        auto result{ parse_list_parallel<T>() };
+        aoc::sort(result);
+        return result;
+    }
+
+private:
+    //==============================================================================
+    [[nodiscard]] bool refill();
+};
+
+} // namespace aoc
@@ -0,0 +1,97 @@
+#include "MappedFile.hpp"
+
+#include "InputFile.hpp"
+
+#include <utility>
+
+#if !defined(_WIN32)
+    #include <sys/mman.h>
+#endif
+
+namespace aoc
+{
+//==============================================================================
+MappedFile::MappedFile(char const * path)
+{
+    InputFile file{ path };
+    if (!file.is_open()) {
+        return;
+    }
+
+    if (auto const preloaded{ file.preloaded() }) {
+        // the loader owns those bytes for the whole solve
+        m_data = preloaded->cbegin();
+        m_size = preloaded->size();
+        return;
+    }
+
+#if !defined(_WIN32)
+    auto const regular_file_size{ file.regular_file_size() };
+    if (regular_file_size && *regular_file_size > 0) {
+        auto const size{ *regular_file_size };
+        auto * const address{ ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file.fd(), 0) };
+        if (address != MAP_FAILED) {
+            ::madvise(address, size, MADV_SEQUENTIAL);
+            m_data = static_cast<char const *>(address);
+            m_size = size;
+            m_is_mapped = true;
+            return;
+        }
+    }
+#endif
+
+    // not mappable : pipe, device, empty or special file
+    file.read_all(m_buffer);
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+}
+
+//==============================================================================
+MappedFile::~MappedFile()
+{
+    release();
+}
+
+//==============================================================================
+MappedFile::MappedFile(MappedFile && other) noexcept
+    : m_data(other.m_data)
+    , m_size(other.m_size)
+    , m_is_mapped(other.m_is_mapped)
+    , m_buffer(std::move(other.m_buffer))
+{
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_is_mapped = false;
+}
+
+//==============================================================================
+MappedFile & MappedFile::operator=(MappedFile && other) noexcept
+{
+    if (this != &other) {
+        release();
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_is_mapped = other.m_is_mapped;
+        m_buffer = std::move(other.m_buffer);
+        other.m_data = nullptr;
+        other.m_size = 0;
+        other.m_is_mapped = false;
+    }
+    return *this;
+}
+
+//==============================================================================
+void MappedFile::release() noexcept
+{
+#if !defined(_WIN32)
+    if (m_is_mapped) {
+        ::munmap(const_cast<char *>(m_data), m_size);
+    }
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_is_mapped = false;
+    m_buffer.clear();
+}
+
+} // namespace aoc
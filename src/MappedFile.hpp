@@ -0,0 +1,45 @@
+#pragma once
+
+#include "StringView.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace aoc
+{
+//==============================================================================
+// Read-only bytes of a file, exposed as a StringView.
+//
+// Regular files are memory-mapped, so the view points straight into the page cache and nothing gets copied. Anything
+// that can't be mapped (pipes, character devices, empty files) is read() into an owned buffer instead.
+class MappedFile
+{
+    char const * m_data{};
+    std::size_t m_size{};
+    bool m_is_mapped{};
+    std::vector<char> m_buffer{};
+
+public:
+    //==============================================================================
+    explicit MappedFile(char const * path);
+    ~MappedFile();
+    //==============================================================================
+    MappedFile(MappedFile const &) = delete;
+    MappedFile(MappedFile && other) noexcept;
+    MappedFile & operator=(MappedFile const &) = delete;
+    MappedFile & operator=(MappedFile && other) noexcept;
+    //==============================================================================
+    [[nodiscard]] StringView view() const noexcept { return StringView{ m_data, m_size }; }
+    operator StringView() const noexcept { return view(); }
+    //==============================================================================
+    [[nodiscard]] char const * data() const noexcept { return m_data; }
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] bool is_mapped() const noexcept { return m_is_mapped; }
+
+private:
+    //==============================================================================
+    void release() noexcept;
+};
+
+} // namespace aoc
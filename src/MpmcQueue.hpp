@@ -0,0 +1,99 @@
+#pragma once
+
+#include "SpscQueue.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace aoc
+{
+//==============================================================================
+// Bounded lock-free queue that any number of threads push to and pop from (D. Vyukov's design).
+//
+// Every slot carries a sequence number telling whose turn it is : a producer claims the slot at the tail when its
+// sequence equals the tail, and publishes the value by bumping the sequence; a consumer claims the slot at the head
+// once it was published, and frees it for the next round of the ring. Threads only compete through a compare-exchange
+// on the tail or the head, never through a lock.
+//
+// try_push() fails when the queue is full and try_pop() when it's empty (or when the next value is still being
+// written).
+template<typename T>
+class Mpmc_Queue
+{
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+    //==============================================================================
+    std::unique_ptr<Slot[]> m_slots;
+    std::size_t m_mask;
+    alignas(detail::CACHE_LINE_SIZE) std::atomic<std::size_t> m_head{};
+    alignas(detail::CACHE_LINE_SIZE) std::atomic<std::size_t> m_tail{};
+
+public:
+    //==============================================================================
+    // capacity must be a power of 2.
+    explicit Mpmc_Queue(std::size_t const capacity) : m_slots(std::make_unique<Slot[]>(capacity)), m_mask(capacity - 1)
+    {
+        assert(capacity > 0 && (capacity & m_mask) == 0);
+        for (std::size_t i{}; i < capacity; ++i) {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    //==============================================================================
+    Mpmc_Queue(Mpmc_Queue const &) = delete;
+    Mpmc_Queue(Mpmc_Queue &&) = delete;
+    Mpmc_Queue & operator=(Mpmc_Queue const &) = delete;
+    Mpmc_Queue & operator=(Mpmc_Queue &&) = delete;
+    //==============================================================================
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_mask + 1; }
+    //==============================================================================
+    [[nodiscard]] bool try_push(T value)
+    {
+        auto tail{ m_tail.load(std::memory_order_relaxed) };
+        while (true) {
+            auto & slot{ m_slots[tail & m_mask] };
+            auto const sequence{ slot.sequence.load(std::memory_order_acquire) };
+            auto const lag{ static_cast<std::ptrdiff_t>(sequence - tail) };
+            if (lag == 0) {
+                if (m_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) {
+                    slot.value = std::move(value);
+                    slot.sequence.store(tail + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                // the slot still holds the value of the previous round
+                return false;
+            } else {
+                tail = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    //==============================================================================
+    [[nodiscard]] bool try_pop(T & value)
+    {
+        auto head{ m_head.load(std::memory_order_relaxed) };
+        while (true) {
+            auto & slot{ m_slots[head & m_mask] };
+            auto const sequence{ slot.sequence.load(std::memory_order_acquire) };
+            auto const lag{ static_cast<std::ptrdiff_t>(sequence - (head + 1)) };
+            if (lag == 0) {
+                if (m_head.compare_exchange_weak(head, head + 1, std::memory_order_relaxed)) {
+                    value = std::move(slot.value);
+                    slot.sequence.store(head + capacity(), std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                // nothing published there yet
+                return false;
+            } else {
+                head = m_head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+} // namespace aoc
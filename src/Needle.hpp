@@ -0,0 +1,97 @@
+#pragma once
+
+#include "StringView.hpp"
+
+namespace aoc
+{
+//==============================================================================
+// A string searched for many times, analysed once (at compile time for constexpr needles).
+//
+// Single characters go straight to the find(char) kernels. Longer needles are found by filtering the haystack on two of
+// their characters, then comparing the few candidates left. Those two are the least common characters of the needle in
+// puzzle inputs, where StringView::find(StringView) always takes the first and last ones. Searching never allocates.
+class Needle
+{
+public:
+    //==============================================================================
+    enum class Strategy { empty, single_char, filtered };
+
+private:
+    StringView m_string;
+    Strategy m_strategy{};
+    std::size_t m_first_offset{};
+    std::size_t m_second_offset{};
+
+public:
+    //==============================================================================
+    constexpr Needle(StringView const & string) noexcept : m_string(string)
+    {
+        if (string.empty()) {
+            m_strategy = Strategy::empty;
+            return;
+        }
+        if (string.size() == 1) {
+            m_strategy = Strategy::single_char;
+            return;
+        }
+
+        m_strategy = Strategy::filtered;
+        std::size_t rarest{};
+        for (std::size_t i{ 1 }; i < string.size(); ++i) {
+            if (frequency_rank(string[i]) < frequency_rank(string[rarest])) {
+                rarest = i;
+            }
+        }
+        std::size_t second_rarest{ rarest == 0 ? std::size_t{ 1 } : std::size_t{} };
+        for (std::size_t i{}; i < string.size(); ++i) {
+            if (i != rarest && frequency_rank(string[i]) < frequency_rank(string[second_rarest])) {
+                second_rarest = i;
+            }
+        }
+        m_first_offset = std::min(rarest, second_rarest);
+        m_second_offset = std::max(rarest, second_rarest);
+    }
+    constexpr Needle(char const * string) noexcept : Needle(StringView{ string }) {}
+    //==============================================================================
+    [[nodiscard]] constexpr StringView const & string() const noexcept { return m_string; }
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return m_string.size(); }
+    [[nodiscard]] constexpr Strategy strategy() const noexcept { return m_strategy; }
+    [[nodiscard]] constexpr std::size_t first_offset() const noexcept { return m_first_offset; }
+    [[nodiscard]] constexpr std::size_t second_offset() const noexcept { return m_second_offset; }
+    //==============================================================================
+    // Same result as haystack.find(string()).
+    [[nodiscard]] constexpr char const * find_in(StringView const & haystack) const noexcept
+    {
+        if (m_strategy == Strategy::empty) {
+            return haystack.cbegin();
+        }
+        if (m_strategy == Strategy::single_char) {
+            return haystack.find(m_string.front());
+        }
+        if (!detail::is_constant_evaluated() && haystack.size() >= detail::MIN_SIZE_FOR_SIMD) {
+            return detail::find_substring(haystack.cbegin(),
+                                          haystack.cend(),
+                                          m_string.cbegin(),
+                                          m_string.size(),
+                                          m_first_offset,
+                                          m_second_offset);
+        }
+        return detail::find_substring_scalar(haystack.cbegin(), haystack.cend(), m_string.cbegin(), m_string.size());
+    }
+    [[nodiscard]] constexpr bool is_in(StringView const & haystack) const noexcept
+    {
+        return find_in(haystack) != haystack.cend();
+    }
+
+private:
+    //==============================================================================
+    // The higher, the more common the character is in the inputs. Unlisted characters rank 0.
+    [[nodiscard]] static constexpr std::size_t frequency_rank(char const c) noexcept
+    {
+        constexpr StringView BY_DECREASING_FREQUENCY{ " \n:etaoinsrhldcu0123456789,.-#" };
+        auto const * const position{ BY_DECREASING_FREQUENCY.find(c) };
+        return static_cast<std::size_t>(BY_DECREASING_FREQUENCY.cend() - position);
+    }
+};
+
+} // namespace aoc
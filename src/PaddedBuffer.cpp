@@ -0,0 +1,47 @@
+#include "PaddedBuffer.hpp"
+
+#include "MappedFile.hpp"
+
+#include <cstring>
+#include <utility>
+
+namespace aoc
+{
+//==============================================================================
+PaddedBuffer::PaddedBuffer(StringView const & string) : m_size(string.size())
+{
+    static constexpr auto ALIGNMENT{ PaddedStringView::ALIGNMENT };
+
+    // round up so that the padding also covers the rest of the last aligned block
+    auto const allocation_size{ (m_size + PaddedStringView::PADDING + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT };
+    m_data.reset(static_cast<char *>(::operator new[](allocation_size, std::align_val_t{ ALIGNMENT })));
+
+    std::memcpy(m_data.get(), string.cbegin(), m_size);
+    std::memset(m_data.get() + m_size, 0, allocation_size - m_size);
+}
+
+//==============================================================================
+PaddedBuffer::PaddedBuffer(PaddedBuffer && other) noexcept : m_data(std::move(other.m_data)), m_size(other.m_size)
+{
+    other.m_size = 0;
+}
+
+//==============================================================================
+PaddedBuffer & PaddedBuffer::operator=(PaddedBuffer && other) noexcept
+{
+    if (this != &other) {
+        m_data = std::move(other.m_data);
+        m_size = other.m_size;
+        other.m_size = 0;
+    }
+    return *this;
+}
+
+//==============================================================================
+PaddedBuffer PaddedBuffer::from_file(char const * path)
+{
+    MappedFile const file{ path };
+    return PaddedBuffer{ file.view() };
+}
+
+} // namespace aoc
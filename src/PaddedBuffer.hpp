@@ -0,0 +1,78 @@
+#pragma once
+
+#include "StringView.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+namespace aoc
+{
+class PaddedBuffer;
+
+//==============================================================================
+// A StringView that comes from a PaddedBuffer.
+//
+// Reading up to PADDING bytes past end() is always valid and yields zeros, so vectorized kernels can load full
+// registers at the tail without bounds checks. Only suffixes keep the guarantee : anything that moves end() decays to
+// a plain StringView.
+class PaddedStringView : public StringView
+{
+    friend class PaddedBuffer;
+
+    //==============================================================================
+    PaddedStringView(char const * begin, std::size_t const size) noexcept : StringView(begin, size) {}
+    PaddedStringView(char const * begin, char const * end) noexcept(!detail::IS_DEBUG) : StringView(begin, end) {}
+
+public:
+    //==============================================================================
+    static constexpr std::size_t ALIGNMENT = 64;
+    static constexpr std::size_t PADDING = 64;
+    //==============================================================================
+    [[nodiscard]] PaddedStringView remove_from_start(std::size_t const size_to_remove) const noexcept
+    {
+        auto const effective_size_to_remove{ std::min(size(), size_to_remove) };
+        return PaddedStringView{ cbegin() + effective_size_to_remove, size() - effective_size_to_remove };
+    }
+    [[nodiscard]] PaddedStringView starting_at(char const * new_begin) const noexcept(!detail::IS_DEBUG)
+    {
+        assert(new_begin >= cbegin() && new_begin <= cend());
+        return PaddedStringView{ new_begin, cend() };
+    }
+};
+
+//==============================================================================
+// Owned copy of some bytes in a 64-byte aligned allocation followed by at least 64 zeroed bytes.
+class PaddedBuffer
+{
+    struct Aligned_Delete {
+        void operator()(char * data) const noexcept
+        {
+            ::operator delete[](data, std::align_val_t{ PaddedStringView::ALIGNMENT });
+        }
+    };
+
+    std::unique_ptr<char[], Aligned_Delete> m_data{};
+    std::size_t m_size{};
+
+public:
+    //==============================================================================
+    explicit PaddedBuffer(StringView const & string);
+    ~PaddedBuffer() = default;
+    //==============================================================================
+    PaddedBuffer(PaddedBuffer const &) = delete;
+    PaddedBuffer(PaddedBuffer && other) noexcept;
+    PaddedBuffer & operator=(PaddedBuffer const &) = delete;
+    PaddedBuffer & operator=(PaddedBuffer && other) noexcept;
+    //==============================================================================
+    [[nodiscard]] static PaddedBuffer from_file(char const * path);
+    //==============================================================================
+    [[nodiscard]] PaddedStringView view() const noexcept { return PaddedStringView{ m_data.get(), m_size }; }
+    operator PaddedStringView() const noexcept { return view(); }
+    //==============================================================================
+    [[nodiscard]] char const * data() const noexcept { return m_data.get(); }
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+};
+
+} // namespace aoc
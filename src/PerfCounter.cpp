@@ -0,0 +1,73 @@
+#include "PerfCounter.hpp"
+
+#if defined(__linux__)
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace aoc
+{
+//==============================================================================
+PerfCounter::PerfCounter([[maybe_unused]] Event const event) noexcept
+{
+#if defined(__linux__)
+    perf_event_attr attributes{};
+    attributes.size = sizeof(attributes);
+    switch (event) {
+    case Event::DTLB_LOAD_MISSES:
+        attributes.type = PERF_TYPE_HW_CACHE;
+        attributes.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                            | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+    case Event::PAGE_FAULTS:
+        attributes.type = PERF_TYPE_SOFTWARE;
+        attributes.config = PERF_COUNT_SW_PAGE_FAULTS;
+        break;
+    }
+    attributes.disabled = 1;
+    // the kernel side is often off limits to unprivileged users
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    m_fd = static_cast<int>(::syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+#endif
+}
+
+//==============================================================================
+PerfCounter::~PerfCounter()
+{
+#if defined(__linux__)
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+#endif
+}
+
+//==============================================================================
+void PerfCounter::start() noexcept
+{
+#if defined(__linux__)
+    if (m_fd >= 0) {
+        ::ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+        ::ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+//==============================================================================
+std::uint64_t PerfCounter::stop() noexcept
+{
+    std::uint64_t count{};
+#if defined(__linux__)
+    if (m_fd >= 0) {
+        ::ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (::read(m_fd, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count))) {
+            count = 0;
+        }
+    }
+#endif
+    return count;
+}
+
+} // namespace aoc
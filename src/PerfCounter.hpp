@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+namespace aoc
+{
+//==============================================================================
+// Counts an event of the calling thread, through perf_event_open on Linux.
+//
+// Virtual machines and locked-down systems often hide the hardware counters : is_available() is false then, and every
+// count is 0. Software events, like page faults, are usually there anyway.
+class PerfCounter
+{
+    int m_fd{ -1 };
+
+public:
+    //==============================================================================
+    enum class Event { DTLB_LOAD_MISSES, PAGE_FAULTS };
+    //==============================================================================
+    explicit PerfCounter(Event event) noexcept;
+    ~PerfCounter();
+    //==============================================================================
+    PerfCounter(PerfCounter const &) = delete;
+    PerfCounter(PerfCounter &&) = delete;
+    PerfCounter & operator=(PerfCounter const &) = delete;
+    PerfCounter & operator=(PerfCounter &&) = delete;
+    //==============================================================================
+    [[nodiscard]] bool is_available() const noexcept { return m_fd >= 0; }
+    //==============================================================================
+    // Counts from zero.
+    void start() noexcept;
+    // The count since start().
+    [[nodiscard]] std::uint64_t stop() noexcept;
+};
+
+} // namespace aoc
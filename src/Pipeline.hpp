@@ -0,0 +1,578 @@
+#pragma once
+
+#include "LineStream.hpp"
+#include "MpmcQueue.hpp"
+#include "SpscQueue.hpp"
+#include "ThreadPool.hpp"
+#include "shortcuts.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace aoc
+{
+namespace detail
+{
+//==============================================================================
+// The stages between the source and the sink, fused into a single call : chain(element, emit) calls emit() with every
+// value that comes out of the last stage (none when a filter rejects the element), without any queue between them.
+struct Identity_Chain {
+    template<typename Input>
+    using output_t = std::decay_t<Input>;
+    //==============================================================================
+    template<typename T, typename Emit>
+    void operator()(T && value, Emit const & emit) const
+    {
+        emit(std::forward<T>(value));
+    }
+};
+
+//==============================================================================
+template<typename Previous, typename Fn>
+struct Transform_Chain {
+    Previous previous;
+    Fn fn;
+    //==============================================================================
+    template<typename Input>
+    using output_t = std::decay_t<std::invoke_result_t<Fn const &, typename Previous::template output_t<Input>>>;
+    //==============================================================================
+    template<typename T, typename Emit>
+    void operator()(T && value, Emit const & emit) const
+    {
+        previous(std::forward<T>(value), [&](auto && previous_value) {
+            emit(fn(std::forward<decltype(previous_value)>(previous_value)));
+        });
+    }
+};
+
+//==============================================================================
+template<typename Previous, typename Pred>
+struct Filter_Chain {
+    Previous previous;
+    Pred pred;
+    //==============================================================================
+    template<typename Input>
+    using output_t = typename Previous::template output_t<Input>;
+    //==============================================================================
+    template<typename T, typename Emit>
+    void operator()(T && value, Emit const & emit) const
+    {
+        previous(std::forward<T>(value), [&](auto && previous_value) {
+            if (pred(std::as_const(previous_value))) {
+                emit(std::forward<decltype(previous_value)>(previous_value));
+            }
+        });
+    }
+};
+
+//==============================================================================
+// Elements read from the source at once. A batch is the unit of work handed between the tasks of a pipeline.
+static constexpr std::size_t PIPELINE_BATCH_SIZE = 256;
+
+//==============================================================================
+// Batches that can wait between the source and the other stages, per task.
+static constexpr std::size_t PIPELINE_BATCHES_PER_TASK = 4;
+
+//==============================================================================
+// Chunks of a LineStream that can wait between the reader and each of the other tasks.
+static constexpr std::size_t PIPELINE_CHUNKS_PER_TASK = 2;
+
+//==============================================================================
+// How many streamed pipelines the current thread is reading (see run_streamed_pipeline()).
+inline thread_local std::size_t pipeline_reading_depth{};
+
+//==============================================================================
+template<typename It>
+[[nodiscard]] It advance_up_to(It first, It const last, std::size_t const count)
+{
+    using category = typename std::iterator_traits<It>::iterator_category;
+    if constexpr (std::is_base_of_v<std::random_access_iterator_tag, category>) {
+        auto const distance{ static_cast<std::size_t>(last - first) };
+        return first + static_cast<typename std::iterator_traits<It>::difference_type>(std::min(count, distance));
+    } else {
+        for (std::size_t i{}; i < count && first != last; ++i) {
+            ++first;
+        }
+        return first;
+    }
+}
+
+//==============================================================================
+[[nodiscard]] constexpr std::size_t next_power_of_2(std::size_t const value) noexcept
+{
+    std::size_t result{ 1 };
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+//==============================================================================
+// Runs the chain on every element of [first, last) and hands its outputs to accumulate(state, output), with one state
+// per task, which the sink then merges.
+//
+// Each task takes the source role in turn (whoever gets the lock first) : it cuts batches out of the source and pushes
+// them to a bounded Mpmc_Queue, until the queue is full or the source is exhausted. The batch that didn't fit is run
+// right away by that task, so that a fast source is held back by the other stages instead of reading ahead without
+// bounds. The other tasks pop batches and run the fused chain on them.
+//
+// Inputs that fit in a single batch, and pools without workers, are run on the calling thread.
+template<typename It, typename Chain, typename State, typename Accumulate>
+[[nodiscard]] std::vector<State> run_pipeline(Thread_Pool & pool,
+                                              It const first,
+                                              It const last,
+                                              Chain const & chain,
+                                              State const & initial_state,
+                                              Accumulate const & accumulate)
+{
+    auto const run_batch = [&](State & state, It const batch_first, It const batch_last) {
+        for (auto it{ batch_first }; it != batch_last; ++it) {
+            chain(*it, [&](auto && output) { accumulate(state, std::forward<decltype(output)>(output)); });
+        }
+    };
+
+    auto const num_tasks{ pool.num_threads() };
+    auto const first_batch_last{ advance_up_to(first, last, PIPELINE_BATCH_SIZE) };
+    if (num_tasks == 1 || first_batch_last == last) {
+        std::vector<State> states{ initial_state };
+        run_batch(states.front(), first, last);
+        return states;
+    }
+
+    struct Batch {
+        It first;
+        It last;
+    };
+    Mpmc_Queue<Batch> queue{ next_power_of_2(num_tasks * PIPELINE_BATCHES_PER_TASK) };
+    std::mutex source_mutex{};
+    auto next_batch_first{ first }; // guarded by source_mutex
+    std::atomic<bool> is_source_done{};
+
+    std::vector<State> states(num_tasks, initial_state);
+    pool.for_each_index(num_tasks, [&](std::size_t const task_index) {
+        auto & state{ states[task_index] };
+        Batch batch{};
+        while (true) {
+            if (queue.try_pop(batch)) {
+                run_batch(state, batch.first, batch.last);
+                continue;
+            }
+            if (is_source_done.load(std::memory_order_acquire)) {
+                // every push happened before, so an empty queue stays empty
+                if (queue.try_pop(batch)) {
+                    run_batch(state, batch.first, batch.last);
+                    continue;
+                }
+                return;
+            }
+
+            std::unique_lock lock{ source_mutex, std::try_to_lock };
+            if (!lock.owns_lock()) {
+                // another task is reading the source
+                std::this_thread::yield();
+                continue;
+            }
+            std::optional<Batch> overflow{};
+            while (next_batch_first != last) {
+                Batch const new_batch{ next_batch_first,
+                                       advance_up_to(next_batch_first, last, PIPELINE_BATCH_SIZE) };
+                next_batch_first = new_batch.last;
+                if (!queue.try_push(new_batch)) {
+                    overflow = new_batch;
+                    break;
+                }
+            }
+            if (next_batch_first == last) {
+                is_source_done.store(true, std::memory_order_release);
+            }
+            lock.unlock();
+
+            if (overflow) {
+                run_batch(state, overflow->first, overflow->last);
+            }
+        }
+    });
+    return states;
+}
+
+//==============================================================================
+// Runs the chain on every line of stream, like run_pipeline() does on a range.
+//
+// The first task to start becomes the reader, and the others the parsers. Each parser is linked to the reader by two
+// Spsc_Queues : the reader copies a chunk of the stream in a buffer, pushes it to a parser with room for it and reads
+// the next chunk while the parser runs the fused chain on the lines of the first. Parsers send the buffers back for
+// the reader to reuse. When no parser has room, the reader runs the chunk itself : it is held back by the other stages
+// and the buffers in flight stay bounded.
+//
+// Parsers sleep while the reader has nothing for them. A parser that starts on a thread that is reading a stream (a
+// stage that waits for tasks picked it up) leaves right away, since the reader it would wait for is below it.
+//
+// Streams that fit in a single chunk go through run_pipeline(), and pools without workers run on the calling thread.
+template<typename Chain, typename State, typename Accumulate>
+[[nodiscard]] std::vector<State> run_streamed_pipeline(Thread_Pool & pool,
+                                                       LineStream & stream,
+                                                       Chain const & chain,
+                                                       State const & initial_state,
+                                                       Accumulate const & accumulate)
+{
+    auto const run_lines = [&](State & state, StringView const & chunk) {
+        auto const lines{ chunk.lines() };
+        for (auto it{ lines.cbegin() }; it != lines.cend(); ++it) {
+            chain(*it, [&](auto && output) { accumulate(state, std::forward<decltype(output)>(output)); });
+        }
+    };
+
+    StringView chunk{};
+    if (!stream.next_chunk(chunk)) {
+        return std::vector<State>{ initial_state };
+    }
+    auto const num_tasks{ pool.num_threads() };
+    if (num_tasks == 1) {
+        std::vector<State> states{ initial_state };
+        do {
+            run_lines(states.front(), chunk);
+        } while (stream.next_chunk(chunk));
+        return states;
+    }
+    if (stream.is_exhausted()) {
+        auto const lines{ chunk.lines() };
+        return run_pipeline(pool, lines.cbegin(), lines.cend(), chain, initial_state, accumulate);
+    }
+
+    using Buffer = std::vector<char>;
+    struct Link {
+        Spsc_Queue<Buffer> chunks{ PIPELINE_CHUNKS_PER_TASK };
+        Spsc_Queue<Buffer> spare_buffers{ PIPELINE_CHUNKS_PER_TASK * 2 };
+        std::atomic<bool> is_open{};
+    };
+    auto const num_links{ num_tasks - 1 };
+    auto const links{ std::make_unique<Link[]>(num_links) };
+
+    std::mutex wake_up_mutex{};
+    std::condition_variable wake_up{};
+    std::size_t num_handed_out{}; // guarded by wake_up_mutex
+    bool is_reading_done{};       // guarded by wake_up_mutex
+
+    auto const take_spare_buffer = [&] {
+        Buffer buffer{};
+        for (std::size_t i{}; i < num_links; ++i) {
+            if (links[i].spare_buffers.try_pop(buffer)) {
+                break;
+            }
+        }
+        return buffer;
+    };
+
+    std::size_t next_link{};
+    auto const hand_out = [&](StringView const & chunk_to_hand_out) {
+        for (std::size_t i{}; i < num_links; ++i) {
+            auto const link_index{ (next_link + i) % num_links };
+            auto & link{ links[link_index] };
+            if (!link.is_open.load(std::memory_order_acquire) || link.chunks.is_full()) {
+                continue;
+            }
+            auto buffer{ take_spare_buffer() };
+            buffer.assign(chunk_to_hand_out.cbegin(), chunk_to_hand_out.cend());
+            [[maybe_unused]] auto const is_pushed{ link.chunks.try_push(std::move(buffer)) };
+            assert(is_pushed);
+            next_link = (link_index + 1) % num_links;
+            {
+                std::lock_guard const lock{ wake_up_mutex };
+                ++num_handed_out;
+            }
+            wake_up.notify_all();
+            return true;
+        }
+        return false;
+    };
+
+    auto const finish_reading = [&] {
+        {
+            std::lock_guard const lock{ wake_up_mutex };
+            is_reading_done = true;
+        }
+        wake_up.notify_all();
+    };
+
+    auto const read = [&](State & state) {
+        ++pipeline_reading_depth;
+        try {
+            auto has_chunk{ true };
+            while (has_chunk && !stream.is_exhausted()) {
+                if (!hand_out(chunk)) {
+                    run_lines(state, chunk);
+                }
+                has_chunk = stream.next_chunk(chunk);
+            }
+            if (has_chunk) {
+                // the last one : there's nothing left to read in the meantime
+                run_lines(state, chunk);
+            }
+        } catch (...) {
+            --pipeline_reading_depth;
+            finish_reading();
+            throw;
+        }
+        --pipeline_reading_depth;
+        finish_reading();
+    };
+
+    auto const parse = [&](Link & link, State & state) {
+        link.is_open.store(true, std::memory_order_release);
+        Buffer buffer{};
+        std::size_t num_seen{};
+        while (true) {
+            if (link.chunks.try_pop(buffer)) {
+                run_lines(state, StringView{ buffer.data(), buffer.size() });
+                // a full queue lets the buffer go
+                static_cast<void>(link.spare_buffers.try_push(std::move(buffer)));
+                continue;
+            }
+            std::unique_lock lock{ wake_up_mutex };
+            if (is_reading_done) {
+                // every push happened before, so an empty queue stays empty
+                lock.unlock();
+                if (link.chunks.try_pop(buffer)) {
+                    run_lines(state, StringView{ buffer.data(), buffer.size() });
+                    continue;
+                }
+                return;
+            }
+            wake_up.wait(lock, [&] { return is_reading_done || num_handed_out != num_seen; });
+            num_seen = num_handed_out;
+        }
+    };
+
+    std::atomic<std::size_t> num_started_tasks{};
+    std::vector<State> states(num_tasks, initial_state);
+    pool.for_each_index(num_tasks, [&](std::size_t const task_index) {
+        if (pipeline_reading_depth != 0) {
+            return;
+        }
+        auto const role{ num_started_tasks.fetch_add(1, std::memory_order_relaxed) };
+        if (role == 0) {
+            read(states[task_index]);
+        } else {
+            parse(links[role - 1], states[task_index]);
+        }
+    });
+    return states;
+}
+
+//==============================================================================
+// What the chain is called with : the elements of a range, or the lines of a LineStream.
+template<typename Source>
+struct Pipeline_Input {
+    using type = decltype(*std::declval<Source const &>().cbegin());
+};
+template<>
+struct Pipeline_Input<LineStream> {
+    using type = StringView const &;
+};
+
+} // namespace detail
+
+//==============================================================================
+// A source range followed by stages, declared like this :
+//
+//      aoc::LineStream stream{ input_file_path };
+//      auto const count{ aoc::make_pipeline(stream)
+//                            .transform(Entry::from_string)
+//                            .filter(is_valid)
+//                            .count(aoc::execution::par) };
+//
+// transform() and filter() don't run anything, they fuse the new stage with the previous ones. The sinks (reduce(),
+// count(), max() and collect()) run the pipeline, sequentially or, with aoc::execution::par, on the tasks of a thread
+// pool (see detail::run_pipeline()). With par, the stages are called concurrently and reduce() must be associative
+// and commutative, since the outputs of each task are merged in no particular order.
+//
+// Lvalue sources are referenced and must outlive the pipeline; rvalue sources are moved into it.
+//
+// A LineStream source is read one chunk at a time, so memory stays bounded by a few chunks. Sequentially, every stage
+// and the sink go over a chunk before the next one is read over it. With par, a reader task reads ahead while the
+// other tasks run the stages on the chunks it handed them (see detail::run_streamed_pipeline()). Either way, the lines
+// only live as long as their chunk, so values that point into them (views) can't be collected. The stream is consumed
+// by the sink.
+template<typename Source, typename Chain = detail::Identity_Chain>
+class Pipeline
+{
+    using source_t = std::remove_reference_t<Source>;
+    using input_t = typename detail::Pipeline_Input<source_t>::type;
+    //==============================================================================
+    Source m_source;
+    Chain m_chain;
+    Thread_Pool * m_pool;
+
+public:
+    //==============================================================================
+    using value_type = typename Chain::template output_t<input_t>;
+    //==============================================================================
+    template<typename Range>
+    Pipeline(Range && source, Chain chain, Thread_Pool & pool)
+        : m_source(std::forward<Range>(source))
+        , m_chain(std::move(chain))
+        , m_pool(&pool)
+    {
+    }
+    //==============================================================================
+    // Stages.
+    template<typename Fn>
+    [[nodiscard]] auto transform(Fn fn) &&
+    {
+        using chain_t = detail::Transform_Chain<Chain, Fn>;
+        return Pipeline<Source, chain_t>{ std::forward<Source>(m_source),
+                                          chain_t{ std::move(m_chain), std::move(fn) },
+                                          *m_pool };
+    }
+    template<typename Pred>
+    [[nodiscard]] auto filter(Pred pred) &&
+    {
+        using chain_t = detail::Filter_Chain<Chain, Pred>;
+        return Pipeline<Source, chain_t>{ std::forward<Source>(m_source),
+                                          chain_t{ std::move(m_chain), std::move(pred) },
+                                          *m_pool };
+    }
+    //==============================================================================
+    // The pool that par runs on, Thread_Pool::instance() by default.
+    [[nodiscard]] Pipeline on(Thread_Pool & pool) &&
+    {
+        m_pool = &pool;
+        return std::move(*this);
+    }
+    //==============================================================================
+    // Sinks.
+    template<typename T, typename Fn>
+    [[nodiscard]] T reduce(T init, Fn const & fn) const
+    {
+        return reduce(execution::seq, std::move(init), fn);
+    }
+    template<typename Policy, typename T, typename Fn>
+    [[nodiscard]] T reduce(Policy const policy, T init, Fn const & fn) const
+    {
+        auto const states{ run(policy, std::optional<T>{}, [&](std::optional<T> & state, auto && value) {
+            if (state) {
+                state = fn(std::move(*state), std::forward<decltype(value)>(value));
+            } else {
+                state = T(std::forward<decltype(value)>(value));
+            }
+        }) };
+        for (auto const & state : states) {
+            if (state) {
+                init = fn(std::move(init), *state);
+            }
+        }
+        return init;
+    }
+    //==============================================================================
+    [[nodiscard]] std::size_t count() const { return count(execution::seq); }
+    template<typename Policy>
+    [[nodiscard]] std::size_t count(Policy const policy) const
+    {
+        auto const states{ run(policy, std::size_t{}, [](std::size_t & state, auto &&) { ++state; }) };
+        return std::accumulate(states.cbegin(), states.cend(), std::size_t{});
+    }
+    //==============================================================================
+    // Nothing when no value reaches the sink.
+    [[nodiscard]] std::optional<value_type> max() const { return max(execution::seq); }
+    template<typename Policy>
+    [[nodiscard]] std::optional<value_type> max(Policy const policy) const
+    {
+        auto const keep_max = [](std::optional<value_type> & state, auto && value) {
+            if (!state || *state < value) {
+                state = std::forward<decltype(value)>(value);
+            }
+        };
+        auto const states{ run(policy, std::optional<value_type>{}, keep_max) };
+        std::optional<value_type> result{};
+        for (auto const & state : states) {
+            if (state && (!result || *result < *state)) {
+                result = state;
+            }
+        }
+        return result;
+    }
+    //==============================================================================
+    // With par, the values are grouped by the task that produced them rather than in the order of the source.
+    [[nodiscard]] std::vector<value_type> collect() const { return collect(execution::seq); }
+    template<typename Policy>
+    [[nodiscard]] std::vector<value_type> collect(Policy const policy) const
+    {
+        auto states{ run(policy, std::vector<value_type>{}, [](std::vector<value_type> & state, auto && value) {
+            state.push_back(std::forward<decltype(value)>(value));
+        }) };
+        auto result{ std::move(states.front()) };
+        for (auto it{ std::next(states.begin()) }; it != states.end(); ++it) {
+            result.insert(result.end(), std::make_move_iterator(it->begin()), std::make_move_iterator(it->end()));
+        }
+        return result;
+    }
+
+private:
+    //==============================================================================
+    // One state per task, never none.
+    template<typename Policy, typename State, typename Accumulate>
+    [[nodiscard]] std::vector<State>
+        run(Policy const policy, State const & initial_state, Accumulate const & accumulate) const
+    {
+        if constexpr (std::is_same_v<source_t, LineStream> && std::is_same_v<Policy, execution::Parallel_Policy>) {
+            return detail::run_streamed_pipeline(*m_pool, m_source, m_chain, initial_state, accumulate);
+        } else if constexpr (std::is_same_v<source_t, LineStream>) {
+            std::vector<State> states{ initial_state };
+            StringView chunk{};
+            while (m_source.next_chunk(chunk)) {
+                auto const lines{ chunk.lines() };
+                auto & state{ states.front() };
+                for (auto it{ lines.cbegin() }; it != lines.cend(); ++it) {
+                    m_chain(*it, [&](auto && output) { accumulate(state, std::forward<decltype(output)>(output)); });
+                }
+            }
+            return states;
+        } else {
+            return run(policy, m_source.cbegin(), m_source.cend(), initial_state, accumulate);
+        }
+    }
+    //==============================================================================
+    template<typename It, typename State, typename Accumulate>
+    [[nodiscard]] std::vector<State> run(execution::Sequenced_Policy,
+                                         It const first,
+                                         It const last,
+                                         State const & initial_state,
+                                         Accumulate const & accumulate) const
+    {
+        std::vector<State> states{ initial_state };
+        for (auto it{ first }; it != last; ++it) {
+            m_chain(*it, [&](auto && output) { accumulate(states.front(), std::forward<decltype(output)>(output)); });
+        }
+        return states;
+    }
+    template<typename It, typename State, typename Accumulate>
+    [[nodiscard]] std::vector<State> run(execution::Parallel_Policy,
+                                         It const first,
+                                         It const last,
+                                         State const & initial_state,
+                                         Accumulate const & accumulate) const
+    {
+        return detail::run_pipeline(*m_pool, first, last, m_chain, initial_state, accumulate);
+    }
+};
+
+//==============================================================================
+template<typename Range>
+[[nodiscard]] Pipeline<Range> make_pipeline(Range && source)
+{
+    return Pipeline<Range>{ std::forward<Range>(source), detail::Identity_Chain{}, Thread_Pool::instance() };
+}
+
+} // namespace aoc
@@ -0,0 +1,43 @@
+#include "Records.hpp"
+
+#include <algorithm>
+
+namespace aoc
+{
+//==============================================================================
+Records::Record Records::record(std::size_t const index) const noexcept(!detail::IS_DEBUG)
+{
+    assert(index < size());
+    if (index == 0) {
+        return Record{ m_index, 0, find_last_line(m_index, 0, 0) };
+    }
+
+    // the blank line is the line right after the line that ends on its first line feed
+    auto const & line_feeds{ m_index.line_feeds() };
+    auto const blank_line_feed{ std::lower_bound(line_feeds.cbegin(),
+                                                 line_feeds.cend(),
+                                                 m_index.blank_lines()[index - 1]) };
+    auto const first_line{ static_cast<std::size_t>(blank_line_feed - line_feeds.cbegin()) + 2 };
+    return Record{ m_index, first_line, find_last_line(m_index, index, first_line) };
+}
+
+//==============================================================================
+std::size_t Records::find_last_line(StructuralIndex const & index,
+                                    std::size_t const record_index,
+                                    std::size_t const first_line) noexcept
+{
+    if (record_index + 1 == index.num_records()) {
+        return index.num_lines() - 1;
+    }
+
+    auto const blank_line_feed{ index.blank_lines()[record_index] };
+    auto const & line_feeds{ index.line_feeds() };
+    auto last_line{ first_line };
+    while (line_feeds[last_line] != blank_line_feed) {
+        assert(line_feeds[last_line] < blank_line_feed);
+        ++last_line;
+    }
+    return last_line;
+}
+
+} // namespace aoc
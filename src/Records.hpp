@@ -0,0 +1,201 @@
+#pragma once
+
+#include "StructuralIndex.hpp"
+
+#include <iterator>
+
+namespace aoc
+{
+//==============================================================================
+// The records of an input made of blank-line-separated groups of lines (the same elements as tokens("\n\n")).
+//
+// A single SIMD pass (see StructuralIndex) finds every line feed and blank line, then records are handed out lazily.
+// Each record knows which lines it spans, so going through its lines reads the offset tables instead of searching the
+// characters again.
+//
+// Records point into the Records that produced them, which must outlive them.
+class Records
+{
+public:
+    //==============================================================================
+    class Line_Iterator
+    {
+        StructuralIndex const * m_index{};
+        std::size_t m_line_index{};
+
+    public:
+        //==============================================================================
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = StringView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = StringView const *;
+        using reference = StringView;
+        //==============================================================================
+        Line_Iterator() noexcept = default;
+        Line_Iterator(StructuralIndex const & index, std::size_t const line_index) noexcept
+            : m_index(&index)
+            , m_line_index(line_index)
+        {
+        }
+        //==============================================================================
+        [[nodiscard]] StringView operator*() const noexcept(!detail::IS_DEBUG) { return m_index->line(m_line_index); }
+        //==============================================================================
+        Line_Iterator & operator++() noexcept
+        {
+            ++m_line_index;
+            return *this;
+        }
+        Line_Iterator operator++(int) noexcept
+        {
+            auto const copy{ *this };
+            ++*this;
+            return copy;
+        }
+        //==============================================================================
+        [[nodiscard]] bool operator==(Line_Iterator const & other) const noexcept
+        {
+            return m_line_index == other.m_line_index;
+        }
+        [[nodiscard]] bool operator!=(Line_Iterator const & other) const noexcept { return !(*this == other); }
+    };
+    //==============================================================================
+    class Line_Range
+    {
+        Line_Iterator m_begin;
+        Line_Iterator m_end;
+
+    public:
+        //==============================================================================
+        using value_type = StringView;
+        using iterator = Line_Iterator;
+        using const_iterator = Line_Iterator;
+        //==============================================================================
+        Line_Range(Line_Iterator const & begin, Line_Iterator const & end) noexcept : m_begin(begin), m_end(end) {}
+        //==============================================================================
+        [[nodiscard]] iterator begin() const noexcept { return m_begin; }
+        [[nodiscard]] iterator end() const noexcept { return m_end; }
+        [[nodiscard]] iterator cbegin() const noexcept { return m_begin; }
+        [[nodiscard]] iterator cend() const noexcept { return m_end; }
+    };
+    //==============================================================================
+    // Lines [first_line, last_line] of the index.
+    class Record
+    {
+        StructuralIndex const * m_index{};
+        std::size_t m_first_line{};
+        std::size_t m_last_line{};
+
+    public:
+        //==============================================================================
+        Record() noexcept = default;
+        Record(StructuralIndex const & index, std::size_t const first_line, std::size_t const last_line) noexcept
+            : m_index(&index)
+            , m_first_line(first_line)
+            , m_last_line(last_line)
+        {
+        }
+        //==============================================================================
+        [[nodiscard]] StringView string() const noexcept(!detail::IS_DEBUG)
+        {
+            return StringView{ m_index->line(m_first_line).cbegin(), m_index->line(m_last_line).cend() };
+        }
+        //==============================================================================
+        // Indexes of the lines in the StructuralIndex.
+        [[nodiscard]] std::size_t first_line() const noexcept { return m_first_line; }
+        [[nodiscard]] std::size_t last_line() const noexcept { return m_last_line; }
+        //==============================================================================
+        [[nodiscard]] std::size_t num_lines() const noexcept { return m_last_line - m_first_line + 1; }
+        [[nodiscard]] StringView line(std::size_t const index) const noexcept(!detail::IS_DEBUG)
+        {
+            assert(index < num_lines());
+            return m_index->line(m_first_line + index);
+        }
+        [[nodiscard]] Line_Range lines() const noexcept
+        {
+            return Line_Range{ Line_Iterator{ *m_index, m_first_line }, Line_Iterator{ *m_index, m_last_line + 1 } };
+        }
+    };
+    //==============================================================================
+    // Walks the line feeds and the blank lines together, so going through all the records costs one step per line.
+    class Iterator
+    {
+        StructuralIndex const * m_index{};
+        std::size_t m_record_index{};
+        Record m_record{};
+
+    public:
+        //==============================================================================
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Record;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Record const *;
+        using reference = Record const &;
+        //==============================================================================
+        Iterator() noexcept = default;
+        Iterator(StructuralIndex const & index, std::size_t const record_index, std::size_t const first_line) noexcept
+            : m_index(&index)
+            , m_record_index(record_index)
+        {
+            if (record_index < index.num_records()) {
+                m_record = Record{ index, first_line, find_last_line(index, record_index, first_line) };
+            }
+        }
+        //==============================================================================
+        [[nodiscard]] reference operator*() const noexcept { return m_record; }
+        [[nodiscard]] pointer operator->() const noexcept { return &m_record; }
+        //==============================================================================
+        Iterator & operator++() noexcept
+        {
+            // skips the blank line
+            *this = Iterator{ *m_index, m_record_index + 1, m_record.last_line() + 2 };
+            return *this;
+        }
+        Iterator operator++(int) noexcept
+        {
+            auto const copy{ *this };
+            ++*this;
+            return copy;
+        }
+        //==============================================================================
+        [[nodiscard]] bool operator==(Iterator const & other) const noexcept
+        {
+            return m_record_index == other.m_record_index;
+        }
+        [[nodiscard]] bool operator!=(Iterator const & other) const noexcept { return !(*this == other); }
+    };
+    //==============================================================================
+    using value_type = Record;
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+
+private:
+    StructuralIndex m_index;
+
+public:
+    //==============================================================================
+    explicit Records(StringView const & string) : m_index(string) {}
+    ~Records() = default;
+    //==============================================================================
+    Records(Records const &) = delete;
+    Records(Records &&) = delete;
+    Records & operator=(Records const &) = delete;
+    Records & operator=(Records &&) = delete;
+    //==============================================================================
+    [[nodiscard]] std::size_t size() const noexcept { return m_index.num_records(); }
+    // Random access, with a binary search of its first line.
+    [[nodiscard]] Record record(std::size_t index) const noexcept(!detail::IS_DEBUG);
+    [[nodiscard]] StructuralIndex const & index() const noexcept { return m_index; }
+    //==============================================================================
+    [[nodiscard]] iterator begin() const noexcept { return Iterator{ m_index, 0, 0 }; }
+    [[nodiscard]] iterator end() const noexcept { return Iterator{ m_index, size(), 0 }; }
+    [[nodiscard]] iterator cbegin() const noexcept { return begin(); }
+    [[nodiscard]] iterator cend() const noexcept { return end(); }
+
+private:
+    //==============================================================================
+    // Steps through the lines from first_line up to the blank line that ends the record.
+    [[nodiscard]] static std::size_t
+        find_last_line(StructuralIndex const & index, std::size_t record_index, std::size_t first_line) noexcept;
+};
+
+} // namespace aoc
@@ -0,0 +1,208 @@
+#include "SimdReduce.hpp"
+
+#include "Cpu.hpp"
+
+#include <algorithm>
+
+#if AOC_X86_DISPATCH
+    #include <immintrin.h>
+#endif
+
+namespace aoc
+{
+namespace detail
+{
+namespace
+{
+//==============================================================================
+using count_equal_32_t = std::size_t (*)(std::uint32_t const *, std::size_t, std::uint32_t) noexcept;
+using count_equal_64_t = std::size_t (*)(std::uint64_t const *, std::size_t, std::uint64_t) noexcept;
+using sum_unsigned_32_t = std::uint64_t (*)(std::uint32_t const *, std::size_t) noexcept;
+using sum_signed_32_t = std::int64_t (*)(std::int32_t const *, std::size_t) noexcept;
+using sum_64_t = std::uint64_t (*)(std::uint64_t const *, std::size_t) noexcept;
+
+//==============================================================================
+struct Reduce_Kernels {
+    count_equal_32_t count_equal_32;
+    count_equal_64_t count_equal_64;
+    sum_unsigned_32_t sum_unsigned_32;
+    sum_signed_32_t sum_signed_32;
+    sum_64_t sum_64;
+};
+
+//==============================================================================
+template<typename T>
+std::size_t count_equal_scalar(T const * data, std::size_t const size, T const value) noexcept
+{
+    std::size_t result{};
+    for (std::size_t i{}; i < size; ++i) {
+        result += static_cast<std::size_t>(data[i] == value);
+    }
+    return result;
+}
+
+//==============================================================================
+template<typename Result, typename T>
+Result sum_scalar(T const * data, std::size_t const size) noexcept
+{
+    Result result{};
+    for (std::size_t i{}; i < size; ++i) {
+        result += static_cast<Result>(data[i]);
+    }
+    return result;
+}
+
+#if AOC_X86_DISPATCH
+//==============================================================================
+__attribute__((target("avx2"))) std::uint64_t horizontal_sum_64(__m256i const lanes) noexcept
+{
+    auto const halves{ _mm_add_epi64(_mm256_castsi256_si128(lanes), _mm256_extracti128_si256(lanes, 1)) };
+    return static_cast<std::uint64_t>(_mm_cvtsi128_si64(halves))
+           + static_cast<std::uint64_t>(_mm_extract_epi64(halves, 1));
+}
+
+//==============================================================================
+// Matches are accumulated as negative 32 bits counters, widened once per round.
+__attribute__((target("avx2"))) std::size_t
+    count_equal_32_avx2(std::uint32_t const * data, std::size_t const size, std::uint32_t const value) noexcept
+{
+    static constexpr std::size_t MAX_BLOCKS_PER_ROUND = UINT32_MAX;
+
+    auto const needle{ _mm256_set1_epi32(static_cast<int>(value)) };
+    std::size_t result{};
+    std::size_t i{};
+    while (size - i >= 8) {
+        auto const blocks{ std::min((size - i) / 8, MAX_BLOCKS_PER_ROUND) };
+        auto counters{ _mm256_setzero_si256() };
+        for (std::size_t block{}; block < blocks; ++block, i += 8) {
+            auto const chunk{ _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data + i)) };
+            counters = _mm256_sub_epi32(counters, _mm256_cmpeq_epi32(chunk, needle));
+        }
+        auto const wide_counters{ _mm256_add_epi64(_mm256_cvtepu32_epi64(_mm256_castsi256_si128(counters)),
+                                                   _mm256_cvtepu32_epi64(_mm256_extracti128_si256(counters, 1))) };
+        result += horizontal_sum_64(wide_counters);
+    }
+    return result + count_equal_scalar(data + i, size - i, value);
+}
+
+//==============================================================================
+__attribute__((target("avx2"))) std::size_t
+    count_equal_64_avx2(std::uint64_t const * data, std::size_t const size, std::uint64_t const value) noexcept
+{
+    auto const needle{ _mm256_set1_epi64x(static_cast<long long>(value)) };
+    auto counters{ _mm256_setzero_si256() };
+    std::size_t i{};
+    for (; i + 4 <= size; i += 4) {
+        auto const chunk{ _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data + i)) };
+        counters = _mm256_sub_epi64(counters, _mm256_cmpeq_epi64(chunk, needle));
+    }
+    return horizontal_sum_64(counters) + count_equal_scalar(data + i, size - i, value);
+}
+
+//==============================================================================
+// Each half of a block is widened to four 64 bits lanes, added to its own accumulator.
+__attribute__((target("avx2"))) std::uint64_t sum_unsigned_32_avx2(std::uint32_t const * data,
+                                                                   std::size_t const size) noexcept
+{
+    auto low_sums{ _mm256_setzero_si256() };
+    auto high_sums{ _mm256_setzero_si256() };
+    std::size_t i{};
+    for (; i + 8 <= size; i += 8) {
+        auto const chunk{ _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data + i)) };
+        low_sums = _mm256_add_epi64(low_sums, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(chunk)));
+        high_sums = _mm256_add_epi64(high_sums, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(chunk, 1)));
+    }
+    return horizontal_sum_64(_mm256_add_epi64(low_sums, high_sums))
+           + sum_scalar<std::uint64_t>(data + i, size - i);
+}
+__attribute__((target("avx2"))) std::int64_t sum_signed_32_avx2(std::int32_t const * data,
+                                                                std::size_t const size) noexcept
+{
+    auto low_sums{ _mm256_setzero_si256() };
+    auto high_sums{ _mm256_setzero_si256() };
+    std::size_t i{};
+    for (; i + 8 <= size; i += 8) {
+        auto const chunk{ _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data + i)) };
+        low_sums = _mm256_add_epi64(low_sums, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(chunk)));
+        high_sums = _mm256_add_epi64(high_sums, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(chunk, 1)));
+    }
+    // the lanes wrap around like unsigned integers, and so does the conversion back
+    return static_cast<std::int64_t>(horizontal_sum_64(_mm256_add_epi64(low_sums, high_sums))
+                                     + sum_scalar<std::uint64_t>(data + i, size - i));
+}
+
+//==============================================================================
+// Two accumulators, so that consecutive additions don't wait for each other.
+__attribute__((target("avx2"))) std::uint64_t sum_64_avx2(std::uint64_t const * data, std::size_t const size) noexcept
+{
+    auto even_sums{ _mm256_setzero_si256() };
+    auto odd_sums{ _mm256_setzero_si256() };
+    std::size_t i{};
+    for (; i + 8 <= size; i += 8) {
+        even_sums = _mm256_add_epi64(even_sums, _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data + i)));
+        odd_sums = _mm256_add_epi64(odd_sums, _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data + i + 4)));
+    }
+    return horizontal_sum_64(_mm256_add_epi64(even_sums, odd_sums)) + sum_scalar<std::uint64_t>(data + i, size - i);
+}
+#endif
+
+//==============================================================================
+Reduce_Kernels select_reduce_kernels() noexcept
+{
+#if AOC_X86_DISPATCH
+    if (cpu::level() >= cpu::Level::V3) {
+        return Reduce_Kernels{ count_equal_32_avx2,
+                               count_equal_64_avx2,
+                               sum_unsigned_32_avx2,
+                               sum_signed_32_avx2,
+                               sum_64_avx2 };
+    }
+#endif
+    return Reduce_Kernels{ count_equal_scalar<std::uint32_t>,
+                           count_equal_scalar<std::uint64_t>,
+                           sum_scalar<std::uint64_t, std::uint32_t>,
+                           sum_scalar<std::int64_t, std::int32_t>,
+                           sum_scalar<std::uint64_t, std::uint64_t> };
+}
+
+//==============================================================================
+Reduce_Kernels const & reduce_kernels() noexcept
+{
+    static Reduce_Kernels const kernels{ select_reduce_kernels() };
+    return kernels;
+}
+
+} // namespace
+
+//==============================================================================
+std::size_t count_equal(std::uint32_t const * data, std::size_t const size, std::uint32_t const value) noexcept
+{
+    return reduce_kernels().count_equal_32(data, size, value);
+}
+
+//==============================================================================
+std::size_t count_equal(std::uint64_t const * data, std::size_t const size, std::uint64_t const value) noexcept
+{
+    return reduce_kernels().count_equal_64(data, size, value);
+}
+
+//==============================================================================
+std::uint64_t sum(std::uint32_t const * data, std::size_t const size) noexcept
+{
+    return reduce_kernels().sum_unsigned_32(data, size);
+}
+
+//==============================================================================
+std::int64_t sum(std::int32_t const * data, std::size_t const size) noexcept
+{
+    return reduce_kernels().sum_signed_32(data, size);
+}
+
+//==============================================================================
+std::uint64_t sum(std::uint64_t const * data, std::size_t const size) noexcept
+{
+    return reduce_kernels().sum_64(data, size);
+}
+
+} // namespace detail
+} // namespace aoc
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace aoc
+{
+namespace detail
+{
+//==============================================================================
+// Reductions of arrays of 32 and 64 bits integers : AVX2 versions when the CPU has it, picked once (see
+// SimdReduce.cpp). aoc::count() and aoc::reduce() use them for contiguous collections of those integers.
+//
+// Sums are accumulated in 64 bits lanes, so 32 bits elements can't overflow them. Signed elements are summed as their
+// unsigned counterparts, which gives the same bits modulo 2^64.
+[[nodiscard]] std::size_t count_equal(std::uint32_t const * data, std::size_t size, std::uint32_t value) noexcept;
+[[nodiscard]] std::size_t count_equal(std::uint64_t const * data, std::size_t size, std::uint64_t value) noexcept;
+[[nodiscard]] std::uint64_t sum(std::uint32_t const * data, std::size_t size) noexcept;
+[[nodiscard]] std::int64_t sum(std::int32_t const * data, std::size_t size) noexcept;
+[[nodiscard]] std::uint64_t sum(std::uint64_t const * data, std::size_t size) noexcept;
+
+} // namespace detail
+} // namespace aoc
@@ -0,0 +1,35 @@
+#include "SolverArena.hpp"
+
+#include <cassert>
+
+namespace aoc
+{
+namespace
+{
+//==============================================================================
+thread_local std::pmr::memory_resource * current_resource{};
+
+} // namespace
+
+//==============================================================================
+SolverArena::SolverArena()
+    : m_resource(INITIAL_SIZE, std::pmr::new_delete_resource())
+    , m_previous_resource(current_resource)
+{
+    current_resource = &m_resource;
+}
+
+//==============================================================================
+SolverArena::~SolverArena()
+{
+    assert(current_resource == &m_resource);
+    current_resource = m_previous_resource;
+}
+
+//==============================================================================
+std::pmr::memory_resource * solver_memory_resource() noexcept
+{
+    return current_resource != nullptr ? current_resource : std::pmr::get_default_resource();
+}
+
+} // namespace aoc
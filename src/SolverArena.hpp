@@ -0,0 +1,39 @@
+#pragma once
+
+#include <memory_resource>
+
+namespace aoc
+{
+//==============================================================================
+// A monotonic arena for the allocations of one solver run, released all at once when the run is over.
+//
+// Allocating is a pointer bump into blocks that grow geometrically, and deallocating does nothing. Solvers reach the
+// arena through solver_memory_resource() and pass it to the std::pmr containers and to the StringView overloads that
+// take a memory resource. What a solver returns must not point into the arena.
+//
+// Like PreloadedInput, the arena is only current on the thread that created it, so concurrent solvers each get theirs.
+class SolverArena
+{
+    std::pmr::monotonic_buffer_resource m_resource;
+    std::pmr::memory_resource * m_previous_resource;
+
+public:
+    //==============================================================================
+    static constexpr std::size_t INITIAL_SIZE = 64 * 1024;
+    //==============================================================================
+    SolverArena();
+    ~SolverArena();
+    //==============================================================================
+    SolverArena(SolverArena const &) = delete;
+    SolverArena(SolverArena &&) = delete;
+    SolverArena & operator=(SolverArena const &) = delete;
+    SolverArena & operator=(SolverArena &&) = delete;
+    //==============================================================================
+    [[nodiscard]] std::pmr::memory_resource * resource() noexcept { return &m_resource; }
+};
+
+//==============================================================================
+// The arena of the innermost SolverArena on this thread, or the default resource outside of any.
+[[nodiscard]] std::pmr::memory_resource * solver_memory_resource() noexcept;
+
+} // namespace aoc
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace aoc
+{
+namespace detail
+{
+//==============================================================================
+// Keeps the indexes written by different threads on different cache lines.
+static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+} // namespace detail
+
+//==============================================================================
+// Bounded lock-free queue between one producer thread and one consumer thread, for a fixed link between two stages.
+//
+// A ring of capacity slots, indexed by two ever-increasing counters : the producer only writes the tail and the
+// consumer only writes the head. Each side keeps a copy of the other side's counter and only reloads it when the ring
+// looks full (or empty), so most operations touch no shared cache line besides the slot itself.
+//
+// try_push() fails when the queue is full (see is_full()), which is how a producer learns to slow down.
+template<typename T>
+class Spsc_Queue
+{
+    std::unique_ptr<T[]> m_slots;
+    std::size_t m_mask;
+    alignas(detail::CACHE_LINE_SIZE) std::atomic<std::size_t> m_head{};
+    std::size_t m_cached_tail{};
+    alignas(detail::CACHE_LINE_SIZE) std::atomic<std::size_t> m_tail{};
+    std::size_t m_cached_head{};
+
+public:
+    //==============================================================================
+    // capacity must be a power of 2.
+    explicit Spsc_Queue(std::size_t const capacity) : m_slots(std::make_unique<T[]>(capacity)), m_mask(capacity - 1)
+    {
+        assert(capacity > 0 && (capacity & m_mask) == 0);
+    }
+    //==============================================================================
+    Spsc_Queue(Spsc_Queue const &) = delete;
+    Spsc_Queue(Spsc_Queue &&) = delete;
+    Spsc_Queue & operator=(Spsc_Queue const &) = delete;
+    Spsc_Queue & operator=(Spsc_Queue &&) = delete;
+    //==============================================================================
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_mask + 1; }
+    //==============================================================================
+    // Producer side. value is only moved from when it's pushed.
+    template<typename U>
+    [[nodiscard]] bool try_push(U && value)
+    {
+        if (is_full()) {
+            return false;
+        }
+        auto const tail{ m_tail.load(std::memory_order_relaxed) };
+        m_slots[tail & m_mask] = std::forward<U>(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    // Only the consumer makes room : when it returns false, the next try_push() succeeds.
+    [[nodiscard]] bool is_full()
+    {
+        auto const tail{ m_tail.load(std::memory_order_relaxed) };
+        if (tail - m_cached_head == capacity()) {
+            m_cached_head = m_head.load(std::memory_order_acquire);
+        }
+        return tail - m_cached_head == capacity();
+    }
+    //==============================================================================
+    // Consumer side.
+    [[nodiscard]] bool try_pop(T & value)
+    {
+        auto const head{ m_head.load(std::memory_order_relaxed) };
+        if (head == m_cached_tail) {
+            m_cached_tail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cached_tail) {
+                return false;
+            }
+        }
+        value = std::move(m_slots[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+} // namespace aoc
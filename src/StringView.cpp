@@ -1,5 +1,386 @@
 #include "StringView.hpp"
 
+#include "Cpu.hpp"
+
+#include <cstring>
+
+#if AOC_X86_DISPATCH
+    #include <immintrin.h>
+#endif
+
 namespace aoc
 {
-}
\ No newline at end of file
+namespace detail
+{
+namespace
+{
+//==============================================================================
+using find_char_t = char const * (*)(char const *, char const *, char) noexcept;
+using count_char_t = std::size_t (*)(char const *, char const *, char) noexcept;
+using find_substring_t = char const * (*)(char const *,
+                                          char const *,
+                                          char const *,
+                                          std::size_t,
+                                          std::size_t,
+                                          std::size_t) noexcept;
+using match_char_set_t = std::uint64_t (*)(char const *, Char_Set const &) noexcept;
+
+//==============================================================================
+struct Char_Kernels {
+    find_char_t find;
+    count_char_t count;
+    find_substring_t find_substring;
+    match_char_set_t match_char_set;
+};
+
+//==============================================================================
+[[maybe_unused]] char const * find_substring_portable(char const * begin,
+                                                      char const * end,
+                                                      char const * needle,
+                                                      std::size_t const needle_size,
+                                                      std::size_t /*first_offset*/,
+                                                      std::size_t /*second_offset*/) noexcept
+{
+    return find_substring_scalar(begin, end, needle, needle_size);
+}
+
+//==============================================================================
+std::uint64_t match_char_set_scalar(char const * block, Char_Set const & set) noexcept
+{
+    std::uint64_t result{};
+    for (std::size_t i{}; i < Char_Set::BLOCK_SIZE; ++i) {
+        if (set.contains(block[i])) {
+            result |= std::uint64_t{ 1 } << i;
+        }
+    }
+    return result;
+}
+
+#if AOC_X86_DISPATCH
+//==============================================================================
+// SSE2 is part of x86-64, so this one needs no target attribute.
+char const * find_char_sse2(char const * begin, char const * end, char const c) noexcept
+{
+    auto const needle{ _mm_set1_epi8(c) };
+    for (; end - begin >= 16; begin += 16) {
+        auto const chunk{ _mm_loadu_si128(reinterpret_cast<__m128i const *>(begin)) };
+        auto const mask{ static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle))) };
+        if (mask != 0) {
+            return begin + __builtin_ctz(mask);
+        }
+    }
+    return find_char_scalar(begin, end, c);
+}
+
+//==============================================================================
+std::size_t count_char_sse2(char const * begin, char const * end, char const c) noexcept
+{
+    auto const needle{ _mm_set1_epi8(c) };
+    std::size_t result{};
+    for (; end - begin >= 16; begin += 16) {
+        auto const chunk{ _mm_loadu_si128(reinterpret_cast<__m128i const *>(begin)) };
+        result += static_cast<std::size_t>(
+            __builtin_popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)))));
+    }
+    return result + count_char_scalar(begin, end, c);
+}
+
+//==============================================================================
+__attribute__((target("avx2,bmi"))) char const *
+    find_char_avx2(char const * begin, char const * end, char const c) noexcept
+{
+    auto const needle{ _mm256_set1_epi8(c) };
+    for (; end - begin >= 32; begin += 32) {
+        auto const chunk{ _mm256_loadu_si256(reinterpret_cast<__m256i const *>(begin)) };
+        auto const mask{ static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle))) };
+        if (mask != 0) {
+            return begin + _tzcnt_u32(mask);
+        }
+    }
+    return find_char_sse2(begin, end, c);
+}
+
+//==============================================================================
+// Matches are accumulated as negative byte counters and only widened every 255 blocks.
+__attribute__((target("avx2"))) std::size_t count_char_avx2(char const * begin, char const * end, char const c) noexcept
+{
+    static constexpr std::ptrdiff_t MAX_BLOCKS_PER_ROUND = 255;
+
+    auto const needle{ _mm256_set1_epi8(c) };
+    auto const zero{ _mm256_setzero_si256() };
+    std::size_t result{};
+    while (end - begin >= 32) {
+        auto const blocks{ std::min((end - begin) / 32, MAX_BLOCKS_PER_ROUND) };
+        auto counters{ zero };
+        for (std::ptrdiff_t i{}; i < blocks; ++i, begin += 32) {
+            auto const chunk{ _mm256_loadu_si256(reinterpret_cast<__m256i const *>(begin)) };
+            counters = _mm256_sub_epi8(counters, _mm256_cmpeq_epi8(chunk, needle));
+        }
+        auto const sums{ _mm256_sad_epu8(counters, zero) };
+        result += static_cast<std::size_t>(_mm256_extract_epi64(sums, 0) + _mm256_extract_epi64(sums, 1)
+                                           + _mm256_extract_epi64(sums, 2) + _mm256_extract_epi64(sums, 3));
+    }
+    return result + count_char_sse2(begin, end, c);
+}
+
+//==============================================================================
+// The tail goes through a masked load, which never touches the bytes past end.
+__attribute__((target("avx512f,avx512bw,bmi,bmi2"))) char const *
+    find_char_avx512(char const * begin, char const * end, char const c) noexcept
+{
+    auto const needle{ _mm512_set1_epi8(c) };
+    for (; end - begin >= 64; begin += 64) {
+        auto const chunk{ _mm512_loadu_si512(begin) };
+        auto const mask{ _mm512_cmpeq_epi8_mask(chunk, needle) };
+        if (mask != 0) {
+            return begin + _tzcnt_u64(mask);
+        }
+    }
+    auto const load_mask{ _bzhi_u64(~std::uint64_t{}, static_cast<unsigned>(end - begin)) };
+    auto const chunk{ _mm512_maskz_loadu_epi8(load_mask, begin) };
+    auto const mask{ _mm512_mask_cmpeq_epi8_mask(load_mask, chunk, needle) };
+    return mask != 0 ? begin + _tzcnt_u64(mask) : end;
+}
+
+//==============================================================================
+__attribute__((target("avx512f,avx512bw,bmi2,popcnt"))) std::size_t
+    count_char_avx512(char const * begin, char const * end, char const c) noexcept
+{
+    auto const needle{ _mm512_set1_epi8(c) };
+    std::size_t result{};
+    for (; end - begin >= 64; begin += 64) {
+        auto const chunk{ _mm512_loadu_si512(begin) };
+        result += static_cast<std::size_t>(_mm_popcnt_u64(_mm512_cmpeq_epi8_mask(chunk, needle)));
+    }
+    auto const load_mask{ _bzhi_u64(~std::uint64_t{}, static_cast<unsigned>(end - begin)) };
+    auto const chunk{ _mm512_maskz_loadu_epi8(load_mask, begin) };
+    return result + static_cast<std::size_t>(_mm_popcnt_u64(_mm512_mask_cmpeq_epi8_mask(load_mask, chunk, needle)));
+}
+
+//==============================================================================
+// Blocks of candidates are loaded at both filter offsets. A block only holds candidates that leave room for the whole
+// needle, so the loads (at most at second_offset <= needle_size - 1) never go past end.
+char const * find_substring_sse2(char const * begin,
+                                 char const * end,
+                                 char const * needle,
+                                 std::size_t const needle_size,
+                                 std::size_t const first_offset,
+                                 std::size_t const second_offset) noexcept
+{
+    if (static_cast<std::size_t>(end - begin) < needle_size) {
+        return end;
+    }
+    auto const first{ _mm_set1_epi8(needle[first_offset]) };
+    auto const second{ _mm_set1_epi8(needle[second_offset]) };
+    auto const * const last_candidate{ end - needle_size + 1 };
+    for (; last_candidate - begin >= 16; begin += 16) {
+        auto const first_chunk{ _mm_loadu_si128(reinterpret_cast<__m128i const *>(begin + first_offset)) };
+        auto const second_chunk{ _mm_loadu_si128(reinterpret_cast<__m128i const *>(begin + second_offset)) };
+        auto const matches{ _mm_and_si128(_mm_cmpeq_epi8(first_chunk, first), _mm_cmpeq_epi8(second_chunk, second)) };
+        auto mask{ static_cast<unsigned>(_mm_movemask_epi8(matches)) };
+        while (mask != 0) {
+            auto const * const candidate{ begin + __builtin_ctz(mask) };
+            if (std::memcmp(candidate, needle, needle_size) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return find_substring_scalar(begin, end, needle, needle_size);
+}
+
+//==============================================================================
+__attribute__((target("avx2,bmi"))) char const *
+    find_substring_avx2(char const * begin,
+                        char const * end,
+                        char const * needle,
+                        std::size_t const needle_size,
+                        std::size_t const first_offset,
+                        std::size_t const second_offset) noexcept
+{
+    if (static_cast<std::size_t>(end - begin) < needle_size) {
+        return end;
+    }
+    auto const first{ _mm256_set1_epi8(needle[first_offset]) };
+    auto const second{ _mm256_set1_epi8(needle[second_offset]) };
+    auto const * const last_candidate{ end - needle_size + 1 };
+    for (; last_candidate - begin >= 32; begin += 32) {
+        auto const first_chunk{ _mm256_loadu_si256(reinterpret_cast<__m256i const *>(begin + first_offset)) };
+        auto const second_chunk{ _mm256_loadu_si256(reinterpret_cast<__m256i const *>(begin + second_offset)) };
+        auto mask{ static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(first_chunk, first), _mm256_cmpeq_epi8(second_chunk, second)))) };
+        while (mask != 0) {
+            auto const * const candidate{ begin + _tzcnt_u32(mask) };
+            if (std::memcmp(candidate, needle, needle_size) == 0) {
+                return candidate;
+            }
+            mask = _blsr_u32(mask);
+        }
+    }
+    return find_substring_sse2(begin, end, needle, needle_size, first_offset, second_offset);
+}
+
+//==============================================================================
+__attribute__((target("avx512f,avx512bw,bmi"))) char const *
+    find_substring_avx512(char const * begin,
+                          char const * end,
+                          char const * needle,
+                          std::size_t const needle_size,
+                          std::size_t const first_offset,
+                          std::size_t const second_offset) noexcept
+{
+    if (static_cast<std::size_t>(end - begin) < needle_size) {
+        return end;
+    }
+    auto const first{ _mm512_set1_epi8(needle[first_offset]) };
+    auto const second{ _mm512_set1_epi8(needle[second_offset]) };
+    auto const * const last_candidate{ end - needle_size + 1 };
+    for (; last_candidate - begin >= 64; begin += 64) {
+        auto const first_chunk{ _mm512_loadu_si512(begin + first_offset) };
+        auto const second_chunk{ _mm512_loadu_si512(begin + second_offset) };
+        auto mask{ _mm512_mask_cmpeq_epi8_mask(_mm512_cmpeq_epi8_mask(first_chunk, first), second_chunk, second) };
+        while (mask != 0) {
+            auto const * const candidate{ begin + _tzcnt_u64(mask) };
+            if (std::memcmp(candidate, needle, needle_size) == 0) {
+                return candidate;
+            }
+            mask = _blsr_u64(mask);
+        }
+    }
+    return find_substring_avx2(begin, end, needle, needle_size, first_offset, second_offset);
+}
+
+//==============================================================================
+// Nibble lookups : the shuffles only read the low 4 bits of each index once its high bit is cleared.
+__attribute__((target("ssse3"))) std::uint64_t match_char_set_ssse3(char const * block, Char_Set const & set) noexcept
+{
+    if (!set.has_nibble_tables()) {
+        return match_char_set_scalar(block, set);
+    }
+    auto const low_table{ _mm_loadu_si128(reinterpret_cast<__m128i const *>(set.low_nibbles().data())) };
+    auto const high_table{ _mm_loadu_si128(reinterpret_cast<__m128i const *>(set.high_nibbles().data())) };
+    auto const nibble_mask{ _mm_set1_epi8(0x0F) };
+    auto const zero{ _mm_setzero_si128() };
+
+    std::uint64_t result{};
+    for (std::size_t i{}; i < Char_Set::BLOCK_SIZE / 16; ++i) {
+        auto const chunk{ _mm_loadu_si128(reinterpret_cast<__m128i const *>(block + i * 16)) };
+        auto const low{ _mm_shuffle_epi8(low_table, _mm_and_si128(chunk, nibble_mask)) };
+        auto const high{ _mm_shuffle_epi8(high_table, _mm_and_si128(_mm_srli_epi16(chunk, 4), nibble_mask)) };
+        auto const misses{ static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(low, high), zero))) };
+        result |= std::uint64_t{ ~misses & 0xFFFFu } << (i * 16);
+    }
+    return result;
+}
+
+//==============================================================================
+__attribute__((target("avx2"))) std::uint64_t match_char_set_avx2(char const * block, Char_Set const & set) noexcept
+{
+    if (!set.has_nibble_tables()) {
+        return match_char_set_scalar(block, set);
+    }
+    auto const low_table{ _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<__m128i const *>(set.low_nibbles().data()))) };
+    auto const high_table{ _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<__m128i const *>(set.high_nibbles().data()))) };
+    auto const nibble_mask{ _mm256_set1_epi8(0x0F) };
+    auto const zero{ _mm256_setzero_si256() };
+
+    std::uint64_t result{};
+    for (std::size_t i{}; i < Char_Set::BLOCK_SIZE / 32; ++i) {
+        auto const chunk{ _mm256_loadu_si256(reinterpret_cast<__m256i const *>(block + i * 32)) };
+        auto const low{ _mm256_shuffle_epi8(low_table, _mm256_and_si256(chunk, nibble_mask)) };
+        auto const high{ _mm256_shuffle_epi8(high_table, _mm256_and_si256(_mm256_srli_epi16(chunk, 4), nibble_mask)) };
+        auto const misses{ static_cast<std::uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(low, high), zero))) };
+        result |= std::uint64_t{ ~misses } << (i * 32);
+    }
+    return result;
+}
+
+//==============================================================================
+__attribute__((target("avx512f,avx512bw"))) std::uint64_t match_char_set_avx512(char const * block,
+                                                                                Char_Set const & set) noexcept
+{
+    if (!set.has_nibble_tables()) {
+        return match_char_set_scalar(block, set);
+    }
+    // the zero-masked broadcast, with every lane selected, compiles to the same vbroadcasti32x4 : the unmasked one is
+    // written with _mm512_undefined_epi32(), which GCC 12 reports as maybe uninitialized
+    static constexpr __mmask16 ALL_LANES = 0xFFFF;
+    auto const low_table{ _mm512_maskz_broadcast_i32x4(
+        ALL_LANES,
+        _mm_loadu_si128(reinterpret_cast<__m128i const *>(set.low_nibbles().data()))) };
+    auto const high_table{ _mm512_maskz_broadcast_i32x4(
+        ALL_LANES,
+        _mm_loadu_si128(reinterpret_cast<__m128i const *>(set.high_nibbles().data()))) };
+    auto const nibble_mask{ _mm512_set1_epi8(0x0F) };
+
+    auto const chunk{ _mm512_loadu_si512(block) };
+    auto const low{ _mm512_shuffle_epi8(low_table, _mm512_and_si512(chunk, nibble_mask)) };
+    auto const high{ _mm512_shuffle_epi8(high_table, _mm512_and_si512(_mm512_srli_epi16(chunk, 4), nibble_mask)) };
+    return _mm512_test_epi8_mask(low, high);
+}
+#endif
+
+//==============================================================================
+Char_Kernels select_char_kernels() noexcept
+{
+#if AOC_X86_DISPATCH
+    auto const level{ cpu::level() };
+    if (level >= cpu::Level::V4) {
+        return Char_Kernels{ find_char_avx512, count_char_avx512, find_substring_avx512, match_char_set_avx512 };
+    }
+    if (level >= cpu::Level::V3) {
+        return Char_Kernels{ find_char_avx2, count_char_avx2, find_substring_avx2, match_char_set_avx2 };
+    }
+    return Char_Kernels{ find_char_sse2,
+                         count_char_sse2,
+                         find_substring_sse2,
+                         level >= cpu::Level::V2 ? match_char_set_ssse3 : match_char_set_scalar };
+#else
+    return Char_Kernels{ find_char_scalar, count_char_scalar, find_substring_portable, match_char_set_scalar };
+#endif
+}
+
+//==============================================================================
+Char_Kernels const & char_kernels() noexcept
+{
+    static Char_Kernels const kernels{ select_char_kernels() };
+    return kernels;
+}
+
+} // namespace
+
+//==============================================================================
+char const * find_char(char const * begin, char const * end, char const c) noexcept
+{
+    return char_kernels().find(begin, end, c);
+}
+
+//==============================================================================
+std::size_t count_char(char const * begin, char const * end, char const c) noexcept
+{
+    return char_kernels().count(begin, end, c);
+}
+
+//==============================================================================
+std::uint64_t match_char_set(char const * block, Char_Set const & set) noexcept
+{
+    return char_kernels().match_char_set(block, set);
+}
+
+//==============================================================================
+char const * find_substring(char const * begin,
+                            char const * end,
+                            char const * needle,
+                            std::size_t const needle_size,
+                            std::size_t const first_offset,
+                            std::size_t const second_offset) noexcept
+{
+    assert(first_offset < second_offset && second_offset < needle_size);
+    return char_kernels().find_substring(begin, end, needle, needle_size, first_offset, second_offset);
+}
+
+} // namespace detail
+} // namespace aoc
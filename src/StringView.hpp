@@ -1,16 +1,28 @@
 #pragma once
 
+#include "hash.hpp"
 #include "narrow.hpp"
 #include "shortcuts.hpp"
 
 #include <algorithm>
+#include <array>
 #include <charconv>
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <iterator>
+#include <memory_resource>
+#include <optional>
 #include <string>
+#include <thread>
+#include <utility>
 
 namespace aoc
 {
 class StringView;
+class Char_Set;
+template<typename Separator>
+class Token_Range;
 
 namespace detail
 {
@@ -40,6 +52,343 @@ void scan_no_prefix(StringView const & string,
     return result;
 }
 
+//==============================================================================
+[[nodiscard]] constexpr bool is_constant_evaluated() noexcept
+{
+#if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+    return __builtin_is_constant_evaluated();
+#else
+    return true;
+#endif
+}
+
+//==============================================================================
+// Reference implementations : used at compile time, on short strings and as the fallback of the SIMD kernels.
+[[nodiscard]] constexpr char const * find_char_scalar(char const * begin, char const * end, char const c) noexcept
+{
+    while (begin != end && *begin != c) {
+        ++begin;
+    }
+    return begin;
+}
+[[nodiscard]] constexpr std::size_t count_char_scalar(char const * begin, char const * end, char const c) noexcept
+{
+    std::size_t result{};
+    for (; begin != end; ++begin) {
+        if (*begin == c) {
+            ++result;
+        }
+    }
+    return result;
+}
+// First occurrence of [needle, needle + needle_size) : memchr-like search on the first character, then a comparison of
+// the rest.
+[[nodiscard]] constexpr char const * find_substring_scalar(char const * begin,
+                                                           char const * end,
+                                                           char const * needle,
+                                                           std::size_t const needle_size) noexcept
+{
+    if (needle_size == 0) {
+        return begin;
+    }
+    if (static_cast<std::size_t>(end - begin) < needle_size) {
+        return end;
+    }
+    auto const * const last_candidate{ end - needle_size + 1 };
+    for (auto const * cur{ find_char_scalar(begin, last_candidate, needle[0]) }; cur != last_candidate;
+         cur = find_char_scalar(cur + 1, last_candidate, needle[0])) {
+        std::size_t i{ 1 };
+        while (i < needle_size && cur[i] == needle[i]) {
+            ++i;
+        }
+        if (i == needle_size) {
+            return cur;
+        }
+    }
+    return end;
+}
+
+//==============================================================================
+// Below this size, calling a SIMD kernel costs more than it saves.
+static constexpr std::size_t MIN_SIZE_FOR_SIMD = 16;
+
+//==============================================================================
+// Below this many bytes per thread, starting a thread costs more than it saves.
+static constexpr std::size_t MIN_BYTES_PER_THREAD = 64 * 1024;
+
+//==============================================================================
+[[nodiscard]] inline std::size_t hardware_threads() noexcept
+{
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+//==============================================================================
+// SSE2, AVX2 or AVX-512 versions, picked once from the CPU features (see StringView.cpp).
+[[nodiscard]] char const * find_char(char const * begin, char const * end, char c) noexcept;
+[[nodiscard]] std::size_t count_char(char const * begin, char const * end, char c) noexcept;
+// Candidates are the positions where the needle bytes at first_offset and second_offset both match, and only those are
+// compared to the whole needle. Requires first_offset < second_offset < needle_size.
+[[nodiscard]] char const * find_substring(char const * begin,
+                                          char const * end,
+                                          char const * needle,
+                                          std::size_t needle_size,
+                                          std::size_t first_offset,
+                                          std::size_t second_offset) noexcept;
+
+//==============================================================================
+// Bit i is set when block[i] is in the set. Reads exactly 64 bytes.
+[[nodiscard]] std::uint64_t match_char_set(char const * block, Char_Set const & set) noexcept;
+
+//==============================================================================
+[[nodiscard]] constexpr unsigned count_trailing_zeros(std::uint64_t const value) noexcept
+{
+    assert(value != 0);
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(value));
+#else
+    unsigned result{};
+    while ((value & (std::uint64_t{ 1 } << result)) == 0) {
+        ++result;
+    }
+    return result;
+#endif
+}
+
+//==============================================================================
+template<auto const & FORMAT, std::size_t... CAPTURE_INDEXES, typename... Ts>
+void scan_compiled(StringView const & string,
+                   std::index_sequence<CAPTURE_INDEXES...>,
+                   Ts &... out_params) noexcept(!detail::IS_DEBUG);
+
+//==============================================================================
+template<typename T>
+static constexpr bool IS_FAST_PARSED_INTEGER = std::is_integral_v<T> && !std::is_same_v<T, bool>
+                                               && !std::is_same_v<T, char>;
+
+//==============================================================================
+// The 8 bytes at bytes as a little-endian word, whatever the byte order of the target : the first byte is the lowest.
+[[nodiscard]] inline std::uint64_t load_little_endian_64(char const * const bytes) noexcept
+{
+    std::uint64_t word;
+    std::memcpy(&word, bytes, sizeof(word));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+}
+
+//==============================================================================
+// Whether the 8 bytes of a little-endian word are all ASCII digits.
+[[nodiscard]] constexpr bool are_eight_digits(std::uint64_t const word) noexcept
+{
+    return ((word & 0xF0F0F0F0F0F0F0F0) | (((word + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4))
+           == 0x3333333333333333;
+}
+
+//==============================================================================
+// SWAR conversion of 8 ASCII digits (the first one in the lowest byte) : pairs, then quads, then the whole word.
+[[nodiscard]] constexpr std::uint32_t parse_eight_digits(std::uint64_t word) noexcept
+{
+    word = (word & 0x0F0F0F0F0F0F0F0F) * (10 * (1 << 8) + 1) >> 8;
+    word = (word & 0x00FF00FF00FF00FF) * (100 * (1 << 16) + 1) >> 16;
+    return static_cast<std::uint32_t>((word & 0x0000FFFF0000FFFF) * (10000 * (std::uint64_t{ 1 } << 32) + 1) >> 32);
+}
+
+//==============================================================================
+// Parses the integer at the start of [begin, end), like std::from_chars but without overflow detection : out of range
+// values wrap around. Returns the end of the digits, or begin when there are none.
+template<typename T>
+[[nodiscard]] char const * parse_integer(char const * begin, char const * end, T & out_value) noexcept
+{
+    static_assert(IS_FAST_PARSED_INTEGER<T>);
+    using unsigned_t = std::make_unsigned_t<T>;
+
+    auto const * cur{ begin };
+    bool is_negative{};
+    if constexpr (std::is_signed_v<T>) {
+        if (cur != end && *cur == '-') {
+            is_negative = true;
+            ++cur;
+        }
+    }
+    auto const * const digits_begin{ cur };
+
+    unsigned_t value{};
+    if constexpr (sizeof(T) >= sizeof(std::uint32_t)) {
+        while (end - cur >= 8) {
+            auto const word{ load_little_endian_64(cur) };
+            if (!are_eight_digits(word)) {
+                break;
+            }
+            value = static_cast<unsigned_t>(value * unsigned_t{ 100000000 } + parse_eight_digits(word));
+            cur += 8;
+        }
+    }
+    for (; cur != end && static_cast<unsigned char>(*cur - '0') < 10; ++cur) {
+        value = static_cast<unsigned_t>(value * unsigned_t{ 10 } + static_cast<unsigned_t>(*cur - '0'));
+    }
+
+    if (cur == digits_begin) {
+        return begin;
+    }
+    out_value = static_cast<T>(is_negative ? static_cast<unsigned_t>(unsigned_t{} - value) : value);
+    return cur;
+}
+
+} // namespace detail
+
+//==============================================================================
+// A scan format whose literals are split out at compile time.
+//
+// Declare it as a constexpr variable at namespace scope and pass it as a template argument :
+//
+//     constexpr aoc::Scan_Format PASSWORD_FORMAT{ "{}-{} {}: {}" };
+//     line.scan<PASSWORD_FORMAT>(min, max, letter, password);
+//
+// The number of captures is checked against the number of out parameters, and each literal is matched with a
+// fixed-offset comparison (the prefix) or a character search, instead of re-reading the format on every call.
+template<std::size_t SIZE>
+class Scan_Format
+{
+public:
+    //==============================================================================
+    struct Literal {
+        std::size_t offset;
+        std::size_t size;
+    };
+    //==============================================================================
+    static constexpr std::size_t MAX_CAPTURES = SIZE / 2;
+
+private:
+    std::array<char, SIZE> m_format{};
+    // the prefix, followed by the literal after each capture
+    std::array<Literal, MAX_CAPTURES + 1> m_literals{};
+    std::size_t m_num_captures{};
+
+public:
+    //==============================================================================
+    constexpr Scan_Format(char const (&format)[SIZE]) noexcept
+    {
+        static_assert(SIZE > 0);
+
+        std::size_t literal_begin{};
+        std::size_t i{};
+        for (; i + 1 < SIZE; ++i) {
+            m_format[i] = format[i];
+            if (format[i] == detail::FORMAT_CAPTURE_PREFIX) {
+                m_literals[m_num_captures++] = Literal{ literal_begin, i - literal_begin };
+                ++i;
+                assert(format[i] == '}');
+                m_format[i] = format[i];
+                literal_begin = i + 1;
+            }
+        }
+        m_literals[m_num_captures] = Literal{ literal_begin, SIZE - 1 - literal_begin };
+    }
+    //==============================================================================
+    [[nodiscard]] constexpr std::size_t num_captures() const noexcept { return m_num_captures; }
+    [[nodiscard]] constexpr char const * data() const noexcept { return m_format.data(); }
+    // 0 is the prefix, i + 1 is the literal that follows capture i.
+    [[nodiscard]] constexpr Literal literal(std::size_t const index) const noexcept { return m_literals[index]; }
+};
+
+//==============================================================================
+// A set of characters, with the lookup tables of a SIMD classifier computed at construction (at compile time for
+// constexpr sets).
+//
+// Each byte is split in two nibbles, looked up in two 16 entries tables with a byte shuffle (pshufb), and the results
+// are ANDed : the byte is in the set when a bit survives. Every distinct high nibble of the set gets its own bit, so
+// the classification is exact for sets that span up to 8 high nibbles, like any set of ASCII characters. Other sets
+// are matched with the bitmap.
+class Char_Set
+{
+    std::array<std::uint64_t, 4> m_bitmap{};
+    std::array<std::uint8_t, 16> m_low_nibbles{};
+    std::array<std::uint8_t, 16> m_high_nibbles{};
+    bool m_has_nibble_tables{ true };
+
+public:
+    //==============================================================================
+    static constexpr std::size_t BLOCK_SIZE = 64;
+    //==============================================================================
+    constexpr Char_Set() noexcept = default;
+    constexpr explicit Char_Set(char const * characters) noexcept
+    {
+        std::array<std::uint8_t, 16> high_nibble_bits{};
+        std::size_t num_high_nibbles{};
+        for (; *characters != '\0'; ++characters) {
+            auto const c{ static_cast<std::uint8_t>(*characters) };
+            m_bitmap[c >> 6] |= std::uint64_t{ 1 } << (c & 63);
+
+            auto const high_nibble{ static_cast<std::size_t>(c >> 4) };
+            if (high_nibble_bits[high_nibble] == 0) {
+                if (num_high_nibbles == 8) {
+                    m_has_nibble_tables = false;
+                    continue;
+                }
+                high_nibble_bits[high_nibble] = static_cast<std::uint8_t>(1u << num_high_nibbles++);
+            }
+            m_high_nibbles[high_nibble] = high_nibble_bits[high_nibble];
+            m_low_nibbles[c & 15] |= high_nibble_bits[high_nibble];
+        }
+    }
+    //==============================================================================
+    [[nodiscard]] constexpr bool contains(char const c) const noexcept
+    {
+        auto const value{ static_cast<std::uint8_t>(c) };
+        return (m_bitmap[value >> 6] >> (value & 63)) & 1;
+    }
+    //==============================================================================
+    // Bit i is set when block[i] is in the set. Reads exactly BLOCK_SIZE bytes.
+    [[nodiscard]] std::uint64_t match(char const * block) const noexcept
+    {
+        return detail::match_char_set(block, *this);
+    }
+    //==============================================================================
+    [[nodiscard]] constexpr bool has_nibble_tables() const noexcept { return m_has_nibble_tables; }
+    [[nodiscard]] constexpr std::array<std::uint8_t, 16> const & low_nibbles() const noexcept { return m_low_nibbles; }
+    [[nodiscard]] constexpr std::array<std::uint8_t, 16> const & high_nibbles() const noexcept
+    {
+        return m_high_nibbles;
+    }
+};
+
+namespace detail
+{
+//==============================================================================
+[[nodiscard]] constexpr char const * find_first_of(char const * begin, char const * end, Char_Set const & set) noexcept
+{
+    if (!is_constant_evaluated()) {
+        for (; end - begin >= static_cast<std::ptrdiff_t>(Char_Set::BLOCK_SIZE); begin += Char_Set::BLOCK_SIZE) {
+            auto const mask{ set.match(begin) };
+            if (mask != 0) {
+                return begin + count_trailing_zeros(mask);
+            }
+        }
+    }
+    while (begin != end && !set.contains(*begin)) {
+        ++begin;
+    }
+    return begin;
+}
+
+//==============================================================================
+// Calls func with a pointer to every character of [begin, end) that is in the set, in order.
+template<typename Func>
+void for_each_match(char const * begin, char const * end, Char_Set const & set, Func const & func)
+{
+    for (; end - begin >= static_cast<std::ptrdiff_t>(Char_Set::BLOCK_SIZE); begin += Char_Set::BLOCK_SIZE) {
+        for (auto mask{ set.match(begin) }; mask != 0; mask &= mask - 1) {
+            func(begin + count_trailing_zeros(mask));
+        }
+    }
+    for (; begin != end; ++begin) {
+        if (set.contains(*begin)) {
+            func(begin);
+        }
+    }
+}
+
 } // namespace detail
 
 //==============================================================================
@@ -109,13 +458,10 @@ public:
     [[nodiscard]] constexpr bool empty() const noexcept { return m_size == 0; }
     [[nodiscard]] constexpr std::size_t count(char const c) const noexcept
     {
-        std::size_t result{};
-        for (auto const & c_ : *this) {
-            if (c_ == c) {
-                ++result;
-            }
+        if (!detail::is_constant_evaluated() && m_size >= detail::MIN_SIZE_FOR_SIMD) {
+            return detail::count_char(cbegin(), cend(), c);
         }
-        return result;
+        return detail::count_char_scalar(cbegin(), cend(), c);
     }
     [[nodiscard]] std::size_t count(StringView const & other) const noexcept
     {
@@ -150,24 +496,39 @@ public:
     }
     [[nodiscard]] constexpr char const * find(char const c) const noexcept
     {
-        char const * cur{ cbegin() };
-        while (cur != cend() && *cur != c) {
-            ++cur;
+        if (!detail::is_constant_evaluated() && m_size >= detail::MIN_SIZE_FOR_SIMD) {
+            return detail::find_char(cbegin(), cend(), c);
         }
-        return cur;
+        return detail::find_char_scalar(cbegin(), cend(), c);
     }
-    [[nodiscard]] char const * find(StringView const & other) const noexcept
+    // Filters on the first and last characters of other. See Needle for repeated searches of the same string.
+    [[nodiscard]] constexpr char const * find(StringView const & other) const noexcept
     {
-        return std::search(cbegin(), cend(), std::boyer_moore_searcher(other.cbegin(), other.cend()));
+        if (other.m_size <= 1) {
+            return other.empty() ? cbegin() : find(other.front());
+        }
+        if (!detail::is_constant_evaluated() && m_size >= detail::MIN_SIZE_FOR_SIMD) {
+            return detail::find_substring(cbegin(), cend(), other.cbegin(), other.m_size, 0, other.m_size - 1);
+        }
+        return detail::find_substring_scalar(cbegin(), cend(), other.cbegin(), other.m_size);
+    }
+    // First character that is in the set.
+    [[nodiscard]] constexpr char const * find(Char_Set const & set) const noexcept
+    {
+        return detail::find_first_of(cbegin(), cend(), set);
     }
     [[nodiscard]] constexpr bool contains(char const c) const noexcept { return find(c) != cend(); }
-    [[nodiscard]] bool contains(StringView const & other) const noexcept { return find(other) != cend(); }
+    [[nodiscard]] constexpr bool contains(StringView const & other) const noexcept { return find(other) != cend(); }
     [[nodiscard]] constexpr bool starts_with(char const c) const noexcept(!detail::IS_DEBUG)
     {
         return !empty() && front() == c;
     }
     //==============================================================================
     [[nodiscard]] constexpr StringView up_to(char const c) const noexcept { return StringView{ cbegin(), find(c) }; }
+    [[nodiscard]] constexpr StringView up_to(Char_Set const & set) const noexcept
+    {
+        return StringView{ cbegin(), find(set) };
+    }
     [[nodiscard]] StringView up_to(StringView const & other) const noexcept
     {
         if (other.empty()) {
@@ -220,7 +581,16 @@ public:
 
         detail::scan_no_prefix(string_without_prefix, format_without_prefix, out_params...);
     }
+    template<auto const & FORMAT, typename... Ts>
+    void scan(Ts &... out_params) const noexcept(!detail::IS_DEBUG)
+    {
+        static_assert(FORMAT.num_captures() == sizeof...(Ts), "The format doesn't have one capture per parameter.");
+        detail::scan_compiled<FORMAT>(*this, std::index_sequence_for<Ts...>{}, out_params...);
+    }
     //==============================================================================
+    // The string must start with a valid T. For integers, that includes fitting in T : out of range values are caught
+    // by an assert in debug builds, and wrap around modulo 2^N in release builds. Use parse_checked() on inputs that
+    // can be out of range.
     template<typename T>
     [[nodiscard]] T parse() const noexcept(!detail::IS_DEBUG)
     {
@@ -234,6 +604,11 @@ public:
             value = front();
         } else if constexpr (std::is_same_v<std::string_view, T>) {
             value = std::string_view{ cbegin(), m_size };
+        } else if constexpr (detail::IS_FAST_PARSED_INTEGER<T>) {
+            [[maybe_unused]] auto const * const digits_end{ detail::parse_integer(cbegin(), cend(), value) };
+            assert(digits_end != cbegin());
+            // overflows are only detected by the checked variant
+            assert(parse_checked<T>() == value);
         } else {
             [[maybe_unused]] auto const error{ std::from_chars(cbegin(), cend(), value) };
             assert(error.ec == std::errc());
@@ -241,19 +616,37 @@ public:
         return value;
     }
     //==============================================================================
+    // Exact std::from_chars semantics : nothing if the string doesn't start with a number or if it is out of range.
+    template<typename T>
+    [[nodiscard]] std::optional<T> parse_checked() const noexcept
+    {
+        T value;
+        auto const error{ std::from_chars(cbegin(), cend(), value) };
+        if (error.ec != std::errc()) {
+            return std::nullopt;
+        }
+        return value;
+    }
+    //==============================================================================
+    // The overloads taking a memory resource allocate the result from it (see SolverArena).
     template<typename T, typename Separator>
     [[nodiscard]] std::vector<T> parse_list(Separator const & separator) const noexcept(!detail::IS_DEBUG)
     {
-        auto const size{ count(separator) + 1 };
-        std::vector<T> result{};
-        result.resize(size);
-        auto cur{ result.begin() };
-
-        auto const parse_and_add = [&](StringView const & string) { *cur++ = string.parse<T>(); };
-
-        iterate(parse_and_add, separator);
-
-        return result;
+        return parse_list_into(std::vector<T>{}, separator);
+    }
+    template<typename T, typename Separator>
+    [[nodiscard]] std::pmr::vector<T> parse_list(Separator const & separator,
+                                                 std::pmr::memory_resource * resource) const noexcept(!detail::IS_DEBUG)
+    {
+        return parse_list_into(std::pmr::vector<T>{ resource }, separator);
+    }
+    //==============================================================================
+    // Single pass over a list of integers : the parser stops right on the separator, so no search is needed. Every
+    // element must fit in T, as with parse().
+    template<typename T>
+    [[nodiscard]] std::vector<T> parse_integer_list(char const separator) const noexcept(!detail::IS_DEBUG)
+    {
+        return parse_integer_list_into(std::vector<T>{}, separator);
     }
     //==============================================================================
     template<typename T, typename Separator>
@@ -290,11 +683,166 @@ public:
         func(cur);
     }
 
+    // Splits on any character of the set, going through the string 64 bytes at a time.
+    template<typename Func>
+    void iterate(Func const & func, Char_Set const & separators) const noexcept
+    {
+        auto const * token_begin{ cbegin() };
+        detail::for_each_match(cbegin(), cend(), separators, [&](char const * separator) {
+            func(StringView{ token_begin, separator });
+            token_begin = std::next(separator);
+        });
+        func(StringView{ token_begin, cend() });
+    }
+
     template<typename Func, typename Separator>
     auto iterate_transform(Func const & func, Separator const & separator) const noexcept
+    {
+        return iterate_transform_into(std::vector<decltype(func(StringView{}))>{}, func, separator);
+    }
+    template<typename Func, typename Separator>
+    auto iterate_transform(Func const & func,
+                           Separator const & separator,
+                           std::pmr::memory_resource * resource) const noexcept
+    {
+        return iterate_transform_into(std::pmr::vector<decltype(func(StringView{}))>{ resource }, func, separator);
+    }
+
+    //==============================================================================
+    // Same results as iterate_transform() and parse_list(), with the elements cut in up to max_threads parts (but
+    // never less than MIN_BYTES_PER_THREAD bytes each) that run on Thread_Pool::instance(). Every part writes to its
+    // own slice of the pre-sized result, so the order is kept. func is called concurrently.
+    template<typename Func>
+    auto iterate_transform_parallel(Func const & func,
+                                    char const separator,
+                                    std::size_t const max_threads = detail::hardware_threads()) const
     {
         using value_type = decltype(func(StringView{}));
+        static_assert(!std::is_same_v<value_type, bool>, "std::vector<bool> can't be written concurrently.");
+        assert(max_threads > 0);
+
+        auto const num_parts{ std::clamp(m_size / detail::MIN_BYTES_PER_THREAD, std::size_t{ 1 }, max_threads) };
+        auto const parts{ partition(separator, num_parts) };
+
+        std::vector<std::size_t> first_indexes(parts.size());
+        std::size_t size{};
+        for (std::size_t i{}; i < parts.size(); ++i) {
+            first_indexes[i] = size;
+            size += parts[i].count(separator) + 1;
+        }
         std::vector<value_type> result{};
+        result.resize(size);
+
+        auto const transform_part = [&](std::size_t const part_index) {
+            auto cur{ result.begin() + aoc::narrow<std::ptrdiff_t>(first_indexes[part_index]) };
+            parts[part_index].iterate([&](StringView const & string) { *cur++ = func(string); }, separator);
+        };
+
+        Thread_Pool::instance().for_each_index(parts.size(), transform_part);
+
+        return result;
+    }
+    template<typename T>
+    [[nodiscard]] std::vector<T> parse_list_parallel(char const separator,
+                                                     std::size_t const max_threads = detail::hardware_threads()) const
+    {
+        return iterate_transform_parallel([](StringView const & string) { return string.parse<T>(); },
+                                          separator,
+                                          max_threads);
+    }
+    //==============================================================================
+    // Cuts the string on separators in up to max_parts runs of whole elements, of about the same size. The elements of
+    // the parts, in order, are the elements of the string.
+    [[nodiscard]] std::vector<StringView> partition(char const separator, std::size_t const max_parts) const
+    {
+        assert(max_parts > 0);
+        std::vector<StringView> result{};
+        result.reserve(max_parts);
+
+        auto const * part_begin{ cbegin() };
+        for (std::size_t part{ 1 }; part < max_parts; ++part) {
+            auto const * const target{ cbegin() + part * m_size / max_parts };
+            if (target < part_begin) {
+                continue;
+            }
+            auto const * const part_end{ StringView{ target, cend() }.find(separator) };
+            if (part_end == cend()) {
+                break;
+            }
+            result.emplace_back(part_begin, part_end);
+            part_begin = std::next(part_end);
+        }
+        result.emplace_back(part_begin, cend());
+
+        return result;
+    }
+
+    //==============================================================================
+    // Lazy, single-pass equivalents of split() : no vector and no counting pass.
+    [[nodiscard]] constexpr Token_Range<char> lines() const noexcept;
+    [[nodiscard]] constexpr Token_Range<char> tokens(char separator) const noexcept;
+    [[nodiscard]] Token_Range<StringView> tokens(StringView const & separator) const noexcept;
+    [[nodiscard]] constexpr Token_Range<Char_Set> tokens(Char_Set const & separators) const noexcept;
+    //==============================================================================
+    template<typename Separator>
+    [[nodiscard]] std::vector<StringView> split(Separator const & separator) const noexcept
+    {
+        return split_into(std::vector<StringView>{}, separator);
+    }
+    template<typename Separator>
+    [[nodiscard]] std::pmr::vector<StringView> split(Separator const & separator,
+                                                     std::pmr::memory_resource * resource) const noexcept
+    {
+        return split_into(std::pmr::vector<StringView>{ resource }, separator);
+    }
+
+private:
+    //==============================================================================
+    // Implementations shared by the std::vector and std::pmr::vector versions, filling the empty vector they're given.
+    template<typename Vector, typename Separator>
+    [[nodiscard]] Vector parse_list_into(Vector result, Separator const & separator) const noexcept(!detail::IS_DEBUG)
+    {
+        using T = typename Vector::value_type;
+        if constexpr (detail::IS_FAST_PARSED_INTEGER<T> && std::is_same_v<Separator, char>) {
+            return parse_integer_list_into(std::move(result), separator);
+        }
+
+        result.resize(count(separator) + 1);
+        auto cur{ result.begin() };
+
+        auto const parse_and_add = [&](StringView const & string) { *cur++ = string.parse<T>(); };
+
+        iterate(parse_and_add, separator);
+
+        return result;
+    }
+    template<typename Vector>
+    [[nodiscard]] Vector parse_integer_list_into(Vector result, char const separator) const noexcept(!detail::IS_DEBUG)
+    {
+        using T = typename Vector::value_type;
+        result.reserve(count(separator) + 1);
+
+        auto const * cur{ cbegin() };
+        while (true) {
+            T value{};
+            auto const * const digits_end{ detail::parse_integer(cur, cend(), value) };
+            assert(digits_end != cur);
+            assert(StringView(cur, StringView{ cur, cend() }.find(separator)).parse<T>() == value);
+            result.push_back(value);
+
+            // anything between the number and the separator is ignored, as with parse()
+            cur = digits_end != cend() && *digits_end == separator ? digits_end
+                                                                   : StringView{ digits_end, cend() }.find(separator);
+            if (cur == cend()) {
+                return result;
+            }
+            ++cur;
+        }
+    }
+    template<typename Vector, typename Func, typename Separator>
+    [[nodiscard]] Vector iterate_transform_into(Vector result, Func const & func, Separator const & separator) const
+        noexcept
+    {
         result.resize(count(separator) + 1);
         auto cur{ result.begin() };
 
@@ -304,13 +852,10 @@ public:
 
         return result;
     }
-
-    template<typename Separator>
-    [[nodiscard]] std::vector<StringView> split(Separator const & separator) const noexcept
+    template<typename Vector, typename Separator>
+    [[nodiscard]] Vector split_into(Vector result, Separator const & separator) const noexcept
     {
-        std::vector<StringView> result{};
-        auto const size{ count(separator) + 1 };
-        result.resize(size);
+        result.resize(count(separator) + 1);
         auto inserter{ result.begin() };
 
         auto const add_element_to_result = [&](StringView const & element) { *inserter++ = element; };
@@ -321,6 +866,119 @@ public:
     }
 };
 
+//==============================================================================
+// Forward iterator over the elements of a string, yielding exactly what StringView::iterate() would.
+template<typename Separator>
+class Token_Iterator
+{
+    StringView m_token{};
+    char const * m_end{};
+    Separator m_separator{};
+    bool m_is_past_end{ true };
+
+public:
+    //==============================================================================
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = StringView;
+    using difference_type = std::ptrdiff_t;
+    using pointer = StringView const *;
+    using reference = StringView const &;
+    //==============================================================================
+    // past-the-end
+    constexpr Token_Iterator() noexcept = default;
+    constexpr Token_Iterator(StringView const & string, Separator const & separator) noexcept
+        : m_token(string.up_to(separator))
+        , m_end(string.cend())
+        , m_separator(separator)
+        , m_is_past_end(false)
+    {
+    }
+    //==============================================================================
+    [[nodiscard]] constexpr reference operator*() const noexcept { return m_token; }
+    [[nodiscard]] constexpr pointer operator->() const noexcept { return &m_token; }
+    //==============================================================================
+    constexpr Token_Iterator & operator++() noexcept
+    {
+        if (m_token.cend() == m_end) {
+            m_is_past_end = true;
+            return *this;
+        }
+        StringView const leftover{ m_token.cend() + separator_size(), m_end };
+        m_token = leftover.up_to(m_separator);
+        return *this;
+    }
+    constexpr Token_Iterator operator++(int) noexcept
+    {
+        auto const copy{ *this };
+        ++*this;
+        return copy;
+    }
+    //==============================================================================
+    [[nodiscard]] constexpr bool operator==(Token_Iterator const & other) const noexcept
+    {
+        if (m_is_past_end || other.m_is_past_end) {
+            return m_is_past_end == other.m_is_past_end;
+        }
+        return m_token.cbegin() == other.m_token.cbegin();
+    }
+    [[nodiscard]] constexpr bool operator!=(Token_Iterator const & other) const noexcept { return !(*this == other); }
+
+private:
+    //==============================================================================
+    [[nodiscard]] constexpr std::size_t separator_size() const noexcept
+    {
+        if constexpr (std::is_same_v<Separator, StringView>) {
+            return m_separator.size();
+        } else {
+            return 1;
+        }
+    }
+};
+
+//==============================================================================
+template<typename Separator>
+class Token_Range
+{
+    StringView m_string;
+    Separator m_separator;
+
+public:
+    //==============================================================================
+    using value_type = StringView;
+    using iterator = Token_Iterator<Separator>;
+    using const_iterator = Token_Iterator<Separator>;
+    //==============================================================================
+    constexpr Token_Range(StringView const & string, Separator const & separator) noexcept
+        : m_string(string)
+        , m_separator(separator)
+    {
+    }
+    //==============================================================================
+    [[nodiscard]] constexpr iterator begin() const noexcept { return iterator{ m_string, m_separator }; }
+    [[nodiscard]] constexpr iterator end() const noexcept { return iterator{}; }
+    [[nodiscard]] constexpr iterator cbegin() const noexcept { return begin(); }
+    [[nodiscard]] constexpr iterator cend() const noexcept { return end(); }
+};
+
+//==============================================================================
+constexpr Token_Range<char> StringView::lines() const noexcept
+{
+    return tokens('\n');
+}
+constexpr Token_Range<char> StringView::tokens(char const separator) const noexcept
+{
+    return Token_Range<char>{ *this, separator };
+}
+inline Token_Range<StringView> StringView::tokens(StringView const & separator) const noexcept
+{
+    assert(!separator.empty());
+    return Token_Range<StringView>{ *this, separator };
+}
+constexpr Token_Range<Char_Set> StringView::tokens(Char_Set const & separators) const noexcept
+{
+    return Token_Range<Char_Set>{ *this, separators };
+}
+
 namespace detail
 {
 template<typename T, typename... Ts>
@@ -343,6 +1001,45 @@ void scan_no_prefix(StringView const & string,
 
     scan_no_prefix(leftover_string, leftover_format, other_out_params...);
 }
+
+//==============================================================================
+template<auto const & FORMAT, std::size_t CAPTURE_INDEX, typename T>
+void scan_capture(char const *& cursor, char const * end, T & out_param) noexcept(!detail::IS_DEBUG)
+{
+    constexpr auto SUFFIX_INFO{ FORMAT.literal(CAPTURE_INDEX + 1) };
+    constexpr StringView SUFFIX{ FORMAT.data() + SUFFIX_INFO.offset, SUFFIX_INFO.size };
+    static_assert(!SUFFIX.empty() || CAPTURE_INDEX + 1 == FORMAT.num_captures(),
+                  "Consecutive captures need a literal between them.");
+
+    assert(cursor < end);
+    StringView const string{ cursor, end };
+
+    char const * capture_end;
+    if constexpr (SUFFIX.empty()) {
+        capture_end = end;
+    } else {
+        capture_end = string.find(SUFFIX);
+    }
+
+    out_param = StringView{ cursor, capture_end }.parse<T>();
+    cursor = capture_end == end ? end : capture_end + SUFFIX.size();
+}
+
+//==============================================================================
+template<auto const & FORMAT, std::size_t... CAPTURE_INDEXES, typename... Ts>
+void scan_compiled(StringView const & string,
+                   std::index_sequence<CAPTURE_INDEXES...>,
+                   Ts &... out_params) noexcept(!detail::IS_DEBUG)
+{
+    constexpr auto PREFIX_INFO{ FORMAT.literal(0) };
+    constexpr StringView PREFIX{ FORMAT.data() + PREFIX_INFO.offset, PREFIX_INFO.size };
+
+    assert(string.size() >= PREFIX.size());
+    assert(StringView(string.cbegin(), PREFIX.size()) == PREFIX);
+
+    auto const * cursor{ string.cbegin() + PREFIX.size() };
+    (scan_capture<FORMAT, CAPTURE_INDEXES>(cursor, string.cend(), out_params), ...);
+}
 } // namespace detail
 } // namespace aoc
 
@@ -352,7 +1049,7 @@ template<>
 struct hash<aoc::StringView> {
     std::size_t operator()(aoc::StringView const & string) const noexcept
     {
-        return hash<std::string_view>{}(std::string_view{ string.cbegin(), string.size() });
+        return static_cast<std::size_t>(aoc::hash_bytes(string.cbegin(), string.size()));
     }
 };
 
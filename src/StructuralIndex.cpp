@@ -0,0 +1,206 @@
+#include "StructuralIndex.hpp"
+
+#include "Cpu.hpp"
+
+#include <array>
+#include <cstring>
+#include <limits>
+
+#if AOC_X86_DISPATCH
+    #include <immintrin.h>
+#endif
+
+namespace aoc
+{
+namespace
+{
+//==============================================================================
+constexpr std::size_t BLOCK_SIZE = 64;
+
+//==============================================================================
+struct Delimiter_Set {
+    std::array<char, StructuralIndex::MAX_DELIMITERS> characters;
+    std::size_t size;
+};
+
+//==============================================================================
+// Bit i is set when byte i of the block matches.
+struct Block_Masks {
+    std::uint64_t line_feeds;
+    std::uint64_t delimiters;
+};
+
+//==============================================================================
+using index_block_t = Block_Masks (*)(char const * block, Delimiter_Set const & delimiters) noexcept;
+
+//==============================================================================
+[[maybe_unused]] Block_Masks index_block_scalar(char const * block, Delimiter_Set const & delimiters) noexcept
+{
+    Block_Masks result{};
+    for (std::size_t i{}; i < BLOCK_SIZE; ++i) {
+        auto const bit{ std::uint64_t{ 1 } << i };
+        if (block[i] == '\n') {
+            result.line_feeds |= bit;
+        }
+        for (std::size_t d{}; d < delimiters.size; ++d) {
+            if (block[i] == delimiters.characters[d]) {
+                result.delimiters |= bit;
+            }
+        }
+    }
+    return result;
+}
+
+#if AOC_X86_DISPATCH
+//==============================================================================
+Block_Masks index_block_sse2(char const * block, Delimiter_Set const & delimiters) noexcept
+{
+    static constexpr std::size_t NUM_CHUNKS = BLOCK_SIZE / 16;
+    __m128i chunks[NUM_CHUNKS];
+    for (std::size_t i{}; i < NUM_CHUNKS; ++i) {
+        chunks[i] = _mm_loadu_si128(reinterpret_cast<__m128i const *>(block + i * 16));
+    }
+
+    Block_Masks result{};
+    auto const line_feed{ _mm_set1_epi8('\n') };
+    for (std::size_t i{}; i < NUM_CHUNKS; ++i) {
+        auto const matches{ static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunks[i], line_feed))) };
+        result.line_feeds |= std::uint64_t{ matches } << (i * 16);
+    }
+    for (std::size_t d{}; d < delimiters.size; ++d) {
+        auto const delimiter{ _mm_set1_epi8(delimiters.characters[d]) };
+        for (std::size_t i{}; i < NUM_CHUNKS; ++i) {
+            auto const matches{ static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunks[i], delimiter))) };
+            result.delimiters |= std::uint64_t{ matches } << (i * 16);
+        }
+    }
+    return result;
+}
+
+//==============================================================================
+__attribute__((target("avx2"))) Block_Masks index_block_avx2(char const * block,
+                                                             Delimiter_Set const & delimiters) noexcept
+{
+    auto const low{ _mm256_loadu_si256(reinterpret_cast<__m256i const *>(block)) };
+    auto const high{ _mm256_loadu_si256(reinterpret_cast<__m256i const *>(block + 32)) };
+
+    Block_Masks result{};
+    auto const line_feed{ _mm256_set1_epi8('\n') };
+    result.line_feeds = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, line_feed)))
+                        | std::uint64_t{ static_cast<std::uint32_t>(
+                                             _mm256_movemask_epi8(_mm256_cmpeq_epi8(high, line_feed))) }
+                              << 32;
+    for (std::size_t d{}; d < delimiters.size; ++d) {
+        auto const delimiter{ _mm256_set1_epi8(delimiters.characters[d]) };
+        result.delimiters |= static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, delimiter)))
+                             | std::uint64_t{ static_cast<std::uint32_t>(
+                                                  _mm256_movemask_epi8(_mm256_cmpeq_epi8(high, delimiter))) }
+                                   << 32;
+    }
+    return result;
+}
+
+//==============================================================================
+__attribute__((target("avx512f,avx512bw"))) Block_Masks index_block_avx512(char const * block,
+                                                                           Delimiter_Set const & delimiters) noexcept
+{
+    auto const chunk{ _mm512_loadu_si512(block) };
+
+    Block_Masks result{};
+    result.line_feeds = _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('\n'));
+    for (std::size_t d{}; d < delimiters.size; ++d) {
+        result.delimiters |= _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8(delimiters.characters[d]));
+    }
+    return result;
+}
+#endif
+
+//==============================================================================
+index_block_t select_index_block() noexcept
+{
+#if AOC_X86_DISPATCH
+    auto const level{ cpu::level() };
+    if (level >= cpu::Level::V4) {
+        return index_block_avx512;
+    }
+    if (level >= cpu::Level::V3) {
+        return index_block_avx2;
+    }
+    return index_block_sse2;
+#else
+    return index_block_scalar;
+#endif
+}
+
+//==============================================================================
+// Turns a match mask into offsets.
+void append_offsets(std::uint64_t mask, std::uint32_t const block_offset, std::vector<std::uint32_t> & offsets)
+{
+    while (mask != 0) {
+        offsets.push_back(block_offset + detail::count_trailing_zeros(mask));
+        mask &= mask - 1;
+    }
+}
+
+} // namespace
+
+//==============================================================================
+StructuralIndex::StructuralIndex(StringView const & string, StringView const & delimiters) : m_string(string)
+{
+    assert(string.size() <= std::numeric_limits<std::uint32_t>::max());
+    assert(delimiters.size() <= MAX_DELIMITERS);
+    assert(!delimiters.contains('\n') && !delimiters.contains('\0'));
+
+    Delimiter_Set delimiter_set{};
+    std::copy(delimiters.cbegin(), delimiters.cend(), delimiter_set.characters.begin());
+    delimiter_set.size = delimiters.size();
+
+    static index_block_t const index_block{ select_index_block() };
+
+    auto const index_and_append = [&](char const * block, std::uint32_t const block_offset) {
+        auto const masks{ index_block(block, delimiter_set) };
+        append_offsets(masks.line_feeds, block_offset, m_line_feeds);
+        append_offsets(masks.delimiters, block_offset, m_delimiters);
+    };
+
+    auto const size{ string.size() };
+    std::size_t offset{};
+    for (; size - offset >= BLOCK_SIZE; offset += BLOCK_SIZE) {
+        index_and_append(string.cbegin() + offset, static_cast<std::uint32_t>(offset));
+    }
+    if (offset < size) {
+        // zero padding never matches, since neither '\n' nor the delimiters are '\0'
+        std::array<char, BLOCK_SIZE> last_block{};
+        std::memcpy(last_block.data(), string.cbegin() + offset, size - offset);
+        index_and_append(last_block.data(), static_cast<std::uint32_t>(offset));
+    }
+
+    // blank lines come from consecutive line feeds, without overlapping (like tokens("\n\n"))
+    for (std::size_t i{ 1 }; i < m_line_feeds.size(); ++i) {
+        auto const first_line_feed{ m_line_feeds[i - 1] };
+        auto const is_blank_line{ m_line_feeds[i] == first_line_feed + 1 };
+        if (is_blank_line && (m_blank_lines.empty() || first_line_feed >= m_blank_lines.back() + 2)) {
+            m_blank_lines.push_back(first_line_feed);
+        }
+    }
+}
+
+//==============================================================================
+StringView StructuralIndex::line(std::size_t const index) const noexcept(!detail::IS_DEBUG)
+{
+    assert(index < num_lines());
+    auto const begin{ index == 0 ? std::size_t{} : m_line_feeds[index - 1] + std::size_t{ 1 } };
+    auto const end{ index == m_line_feeds.size() ? m_string.size() : m_line_feeds[index] };
+    return StringView{ m_string.cbegin() + begin, m_string.cbegin() + end };
+}
+
+//==============================================================================
+StringView StructuralIndex::record(std::size_t const index) const noexcept(!detail::IS_DEBUG)
+{
+    assert(index < num_records());
+    auto const begin{ index == 0 ? std::size_t{} : m_blank_lines[index - 1] + std::size_t{ 2 } };
+    auto const end{ index == m_blank_lines.size() ? m_string.size() : m_blank_lines[index] };
+    return StringView{ m_string.cbegin() + begin, m_string.cbegin() + end };
+}
+
+} // namespace aoc
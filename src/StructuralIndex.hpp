@@ -0,0 +1,86 @@
+#pragma once
+
+#include "StringView.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace aoc
+{
+//==============================================================================
+// Offsets of the structural characters of an input, found in a single SIMD pass (simdjson's "stage 1").
+//
+// Three sorted offset tables are built :
+//  - every line feed;
+//  - every blank line, as the offset of the first of its two line feeds (the same boundaries as tokens("\n\n"));
+//  - every occurrence of the chosen delimiters.
+// With them, line and record i are reached without scanning, and the lines can be split evenly between threads.
+//
+// Offsets are 32 bits wide : the input must be smaller than 4 GiB.
+class StructuralIndex
+{
+    StringView m_string;
+    std::vector<std::uint32_t> m_line_feeds{};
+    std::vector<std::uint32_t> m_blank_lines{};
+    std::vector<std::uint32_t> m_delimiters{};
+
+public:
+    //==============================================================================
+    static constexpr std::size_t MAX_DELIMITERS = 4;
+    //==============================================================================
+    // delimiters may be empty, and shouldn't contain '\n'.
+    explicit StructuralIndex(StringView const & string, StringView const & delimiters = "");
+    //==============================================================================
+    [[nodiscard]] StringView string() const noexcept { return m_string; }
+    [[nodiscard]] std::vector<std::uint32_t> const & line_feeds() const noexcept { return m_line_feeds; }
+    [[nodiscard]] std::vector<std::uint32_t> const & blank_lines() const noexcept { return m_blank_lines; }
+    [[nodiscard]] std::vector<std::uint32_t> const & delimiters() const noexcept { return m_delimiters; }
+    //==============================================================================
+    // Same elements as lines().
+    [[nodiscard]] std::size_t num_lines() const noexcept { return m_line_feeds.size() + 1; }
+    [[nodiscard]] StringView line(std::size_t index) const noexcept(!detail::IS_DEBUG);
+    //==============================================================================
+    // Same results as string().iterate_transform(func, '\n'), with the lines cut in up to max_threads runs of the same
+    // number of lines (but never less than MIN_BYTES_PER_THREAD bytes per run on average) that run on
+    // Thread_Pool::instance(). The line feeds are already known : no part of the string is searched again. func is
+    // called concurrently.
+    template<typename Func>
+    auto transform_lines_parallel(Func const & func, std::size_t const max_threads = detail::hardware_threads()) const
+    {
+        using value_type = decltype(func(StringView{}));
+        static_assert(!std::is_same_v<value_type, bool>, "std::vector<bool> can't be written concurrently.");
+        assert(max_threads > 0);
+
+        auto const count{ num_lines() };
+        auto const max_parts{ std::min(max_threads, count) };
+        auto const num_parts{ std::clamp(m_string.size() / detail::MIN_BYTES_PER_THREAD, std::size_t{ 1 }, max_parts) };
+
+        std::vector<value_type> result{};
+        result.resize(count);
+
+        auto const transform_part = [&](std::size_t const part_index) {
+            auto const first_line{ part_index * count / num_parts };
+            auto const last_line{ (part_index + 1) * count / num_parts };
+            auto const * const string_begin{ m_string.cbegin() };
+            for (auto index{ first_line }; index < last_line; ++index) {
+                auto const * const begin{ index == 0 ? string_begin : string_begin + m_line_feeds[index - 1] + 1 };
+                auto const * const end{ index < m_line_feeds.size() ? string_begin + m_line_feeds[index]
+                                                                    : m_string.cend() };
+                result[index] = func(StringView{ begin, end });
+            }
+        };
+
+        Thread_Pool::instance().for_each_index(num_parts, transform_part);
+
+        return result;
+    }
+    //==============================================================================
+    // Same elements as tokens("\n\n").
+    [[nodiscard]] std::size_t num_records() const noexcept { return m_blank_lines.size() + 1; }
+    [[nodiscard]] StringView record(std::size_t index) const noexcept(!detail::IS_DEBUG);
+};
+
+} // namespace aoc
@@ -0,0 +1,170 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <exception>
+
+namespace aoc
+{
+namespace
+{
+//==============================================================================
+// The deque of the current thread, when it's a worker of this pool.
+thread_local Thread_Pool const * current_pool{};
+thread_local std::size_t current_queue_index{};
+
+} // namespace
+
+//==============================================================================
+Thread_Pool::Thread_Pool(unsigned const num_threads)
+{
+    assert(num_threads > 0);
+    auto const num_workers{ num_threads - 1 };
+    // without workers, the queue is only there for the waiting threads to empty
+    auto const num_queues{ std::max(num_workers, 1u) };
+    m_queues.reserve(num_queues);
+    for (unsigned i{}; i < num_queues; ++i) {
+        m_queues.push_back(std::make_unique<Task_Queue>());
+    }
+    m_threads.reserve(num_workers);
+    for (unsigned i{}; i < num_workers; ++i) {
+        m_threads.emplace_back([this, i] { work(i); });
+    }
+}
+
+//==============================================================================
+Thread_Pool::~Thread_Pool()
+{
+    {
+        std::lock_guard const lock{ m_sleep_mutex };
+        m_is_stopping = true;
+    }
+    m_wake_up.notify_all();
+    for (auto & thread : m_threads) {
+        thread.join();
+    }
+}
+
+//==============================================================================
+Thread_Pool & Thread_Pool::instance()
+{
+    static Thread_Pool pool{ std::max(std::thread::hardware_concurrency(), 1u) };
+    return pool;
+}
+
+//==============================================================================
+void Thread_Pool::submit(Task task)
+{
+    {
+        // counted before it's visible, so that try_run_task() can never take it first and bring the count below zero
+        // (under the lock, so that a worker can't check for tasks and then miss the notification)
+        std::lock_guard const lock{ m_sleep_mutex };
+        ++m_num_queued_tasks;
+    }
+    auto const queue_index{ current_pool == this ? current_queue_index : m_next_queue++ % m_queues.size() };
+    auto & queue{ *m_queues[queue_index] };
+    {
+        std::lock_guard const lock{ queue.mutex };
+        queue.tasks.push_back(std::move(task));
+    }
+    m_wake_up.notify_one();
+}
+
+//==============================================================================
+void Thread_Pool::for_each_index(std::size_t const count, std::function<void(std::size_t)> const & func)
+{
+    if (count == 1) {
+        func(0);
+        return;
+    }
+
+    std::atomic<std::size_t> num_remaining{ count };
+    std::atomic<bool> has_failed{};
+    std::exception_ptr error{};
+
+    for (std::size_t i{}; i < count; ++i) {
+        submit([this, &func, &num_remaining, &has_failed, &error, i] {
+            try {
+                func(i);
+            } catch (...) {
+                // only the first one is kept, and read once every call is done
+                if (!has_failed.exchange(true, std::memory_order_relaxed)) {
+                    error = std::current_exception();
+                }
+            }
+            if (num_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                // under the lock, so that the waiting thread can't check and then miss the notification
+                std::lock_guard const lock{ m_sleep_mutex };
+                m_wake_up.notify_all();
+            }
+        });
+    }
+
+    auto const queue_index{ current_pool == this ? current_queue_index : std::size_t{} };
+    while (num_remaining.load(std::memory_order_acquire) != 0) {
+        if (try_run_task(queue_index)) {
+            continue;
+        }
+        // the last tasks are running on other threads : sleep until they're done, or until there's work to help with
+        std::unique_lock lock{ m_sleep_mutex };
+        m_wake_up.wait(lock, [&] {
+            return num_remaining.load(std::memory_order_acquire) == 0 || m_num_queued_tasks.load() != 0;
+        });
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+//==============================================================================
+bool Thread_Pool::try_run_task(std::size_t const queue_index)
+{
+    if (m_num_queued_tasks.load(std::memory_order_relaxed) == 0) {
+        return false;
+    }
+
+    Task task{};
+    for (std::size_t i{}; i < m_queues.size() && !task; ++i) {
+        auto & queue{ *m_queues[(queue_index + i) % m_queues.size()] };
+        std::lock_guard const lock{ queue.mutex };
+        if (queue.tasks.empty()) {
+            continue;
+        }
+        // newest of our own tasks, oldest of the others
+        if (i == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+    }
+    if (!task) {
+        return false;
+    }
+
+    --m_num_queued_tasks;
+    task();
+    return true;
+}
+
+//==============================================================================
+void Thread_Pool::work(std::size_t const queue_index)
+{
+    current_pool = this;
+    current_queue_index = queue_index;
+
+    while (true) {
+        if (try_run_task(queue_index)) {
+            continue;
+        }
+        std::unique_lock lock{ m_sleep_mutex };
+        m_wake_up.wait(lock, [this] { return m_num_queued_tasks.load() != 0 || m_is_stopping; });
+        if (m_is_stopping && m_num_queued_tasks.load() == 0) {
+            return;
+        }
+    }
+}
+
+} // namespace aoc
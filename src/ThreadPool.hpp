@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace aoc
+{
+//==============================================================================
+// Worker threads, each with its own deque of tasks.
+//
+// A worker runs the newest task of its own deque first (its data is still in cache), and when that one is empty,
+// steals the oldest task of another deque. Threads outside of the pool hand their tasks out in turn.
+//
+// Waiting for tasks (see for_each_index()) runs queued tasks, so tasks can start and wait for tasks of their own
+// without deadlocking the pool. The waiting thread only sleeps when there's nothing left to steal.
+class Thread_Pool
+{
+public:
+    //==============================================================================
+    using Task = std::function<void()>;
+
+private:
+    //==============================================================================
+    struct Task_Queue {
+        std::mutex mutex{};
+        std::deque<Task> tasks{};
+    };
+    //==============================================================================
+    std::vector<std::unique_ptr<Task_Queue>> m_queues{};
+    std::vector<std::thread> m_threads{};
+    std::atomic<std::size_t> m_num_queued_tasks{};
+    std::atomic<std::size_t> m_next_queue{};
+    std::mutex m_sleep_mutex{};
+    std::condition_variable m_wake_up{};
+    bool m_is_stopping{};
+
+public:
+    //==============================================================================
+    // The threads calling for_each_index() take part in the work, so num_threads - 1 workers are started.
+    explicit Thread_Pool(unsigned num_threads);
+    ~Thread_Pool();
+    //==============================================================================
+    Thread_Pool(Thread_Pool const &) = delete;
+    Thread_Pool(Thread_Pool &&) = delete;
+    Thread_Pool & operator=(Thread_Pool const &) = delete;
+    Thread_Pool & operator=(Thread_Pool &&) = delete;
+    //==============================================================================
+    // Shared pool, with one thread per core.
+    [[nodiscard]] static Thread_Pool & instance();
+    //==============================================================================
+    [[nodiscard]] std::size_t num_threads() const noexcept { return m_threads.size() + 1; }
+    //==============================================================================
+    // The task must not throw.
+    void submit(Task task);
+    // Calls func(i) for every i in [0, count), concurrently, and returns once they're all done. If some calls throw,
+    // the first exception is rethrown then.
+    void for_each_index(std::size_t count, std::function<void(std::size_t)> const & func);
+
+private:
+    //==============================================================================
+    // Runs a task from the given deque, or else stolen from another one. Returns false when there was none.
+    bool try_run_task(std::size_t queue_index);
+    void work(std::size_t queue_index);
+};
+
+} // namespace aoc
@@ -41,6 +41,7 @@
 //
 // In your expense report, what is the product of the three entries that sum to 2020?
 
+#include "LineStream.hpp"
 #include "StringView.hpp"
 #include "utils.hpp"
 
@@ -49,8 +50,7 @@ static constexpr auto TARGET_VALUE = 2020;
 //==============================================================================
 std::string day_1_a(const char * input_file_path)
 {
-    auto const input{ aoc::read_file(input_file_path) };
-    auto const numbers{ aoc::StringView{ input }.parse_list_and_sort<int>('\n') };
+    auto const numbers{ aoc::LineStream{ input_file_path }.parse_list_and_sort_parallel<int>() };
 
     auto small{ numbers.cbegin() };
     auto big{ numbers.cend() - 1 };
@@ -73,8 +73,7 @@ std::string day_1_a(const char * input_file_path)
 //==============================================================================
 std::string day_1_b(const char * input_file_path)
 {
-    auto const input{ aoc::read_file(input_file_path) };
-    auto const numbers{ aoc::StringView{ input }.parse_list_and_sort<int>('\n') };
+    auto const numbers{ aoc::LineStream{ input_file_path }.parse_list_and_sort_parallel<int>() };
 
     auto small{ numbers.cbegin() };
     auto middle{ numbers.cbegin() + 1 };
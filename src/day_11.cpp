@@ -242,19 +242,19 @@ public:
     //==============================================================================
     Ferry(aoc::StringView const & input) noexcept
     {
-        auto const lines{ input.split('\n') };
+        m_width = input.up_to('\n').size();
 
-        m_width = lines.front().size();
-        m_height = lines.size();
+        // upper bound : every character but the line feeds is a tile
+        m_tiles.reserve(input.size());
 
-        m_tiles.reserve(m_width * m_height);
-
-        for (auto const & line : lines) {
+        for (auto const & line : input.lines()) {
             assert(line.size() == m_width);
             for (auto const character : line) {
                 m_tiles.push_back(parse_tile(character));
             }
         }
+
+        m_height = m_tiles.size() / m_width;
     }
 
     [[nodiscard]] size_t run_neighbors() noexcept { return run(&Ferry::count_neighbors, 4); }
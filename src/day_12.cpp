@@ -78,6 +78,7 @@
 // Figure out where the navigation instructions actually lead.What is the Manhattan distance between that location and
 // the ship's starting position?
 
+#include "LineStream.hpp"
 #include "utils.hpp"
 #include <resources.hpp>
 
@@ -225,17 +226,9 @@ Position & apply_step(Position & position, Step const & step)
 //==============================================================================
 std::string day_12_a(char const * input_file_path)
 {
-    auto const input{ aoc::read_file(input_file_path) };
-    auto const lines{ aoc::split(input, '\n') };
-
-    std::vector<Step> steps{};
-    steps.resize(lines.size());
-    aoc::transform(lines, steps, parse_step);
-
     Position position{ 0, 0, Direction::east };
-    for (auto const & step : steps) {
-        apply_step(position, step);
-    }
+    aoc::LineStream{ input_file_path }.iterate(
+        [&position](aoc::StringView const & line) { apply_step(position, parse_step(line)); });
 
     auto const manhattan_distance{ std::abs(position.x) + std::abs(position.y) };
 
@@ -245,20 +238,11 @@ std::string day_12_a(char const * input_file_path)
 //==============================================================================
 std::string day_12_b(char const * input_file_path)
 {
-    auto const input{ aoc::read_file(input_file_path) };
-    auto const lines{ aoc::split(input, '\n') };
-
-    std::vector<Step> steps{};
-    steps.reserve(lines.size());
-
-    for (auto const & line : lines) {
-        steps.emplace_back(parse_step(line));
-    }
-
     Point boat{ 0, 0 };
     Point waypoint{ 10, -1 };
 
-    for (auto const & step : steps) {
+    aoc::LineStream{ input_file_path }.iterate([&boat, &waypoint](aoc::StringView const & line) {
+        auto const step{ parse_step(line) };
         switch (step.action) {
         case Action::north:
             waypoint.advance(step.amount, Direction::north);
@@ -284,7 +268,7 @@ std::string day_12_b(char const * input_file_path)
         default:
             assert(false);
         }
-    }
+    });
 
     auto const manhattan_distance{ std::abs(boat.x) + std::abs(boat.y) };
     return std::to_string(manhattan_distance);
@@ -117,29 +117,17 @@
 // Execute the initialization program using an emulator for a version 2 decoder chip.What is the sum of all values left
 // in memory after it completes ?
 
-#include <unordered_map>
+#include <bitset>
 
+#include "FlatMap.hpp"
+#include "LineStream.hpp"
 #include "utils.hpp"
 #include <resources.hpp>
 
 namespace
 {
 //==============================================================================
-class Memory : public std::unordered_map<uint64_t, uint64_t>
-{
-    using unordered_map::unordered_map;
-
-public:
-    [[nodiscard]] uint64_t sum_values() const noexcept
-    {
-        auto const sum{ aoc::transform_reduce(
-            *this,
-            uint64_t{},
-            [](value_type const & node) { return node.second; },
-            std::plus()) };
-        return sum;
-    }
-};
+using Memory = aoc::Flat_Map<uint64_t, uint64_t>;
 
 //==============================================================================
 struct Operation {
@@ -158,6 +146,12 @@ struct Mask {
     //==============================================================================
     [[nodiscard]] uint64_t apply_part_b(uint64_t const & value) const { return (value & zeros) | ones; }
     //==============================================================================
+    [[nodiscard]] size_t get_number_of_floating_permutations() const
+    {
+        auto const number_of_floating_bits{ LENGTH - std::bitset<LENGTH>{ ones | zeros }.count() };
+        return size_t{ 1 } << number_of_floating_bits;
+    }
+    //==============================================================================
     void register_floating_permutations(std::vector<uint64_t> & out) const
     {
         out.clear();
@@ -214,12 +208,14 @@ struct Init_Section {
 };
 
 //==============================================================================
-[[nodiscard]] std::vector<Init_Section> parse_init_sequence(std::string const & input)
+constexpr aoc::Scan_Format MEMORY_ASSIGNATION_FORMAT{ "mem[{}] = {}" };
+
+//==============================================================================
+[[nodiscard]] std::vector<Init_Section> parse_init_sequence(char const * input_file_path)
 {
-    auto const lines{ aoc::split(input, '\n') };
     std::vector<Init_Section> result;
 
-    for (auto const & line : lines) {
+    aoc::LineStream{ input_file_path }.iterate([&result](aoc::StringView const & line) {
         if (line[1] == 'a') {
             // first word is "mask" : mask definition line
             auto const mask{ line.starting_after("mask = ") };
@@ -231,10 +227,10 @@ struct Init_Section {
             assert(line[1] == 'e');
             uint64_t address;
             uint64_t value;
-            line.scan("mem[{}] = {}", address, value);
+            line.scan<MEMORY_ASSIGNATION_FORMAT>(address, value);
             result.back().operations.push_back(Operation{ address, value });
         }
-    }
+    });
 
     return result;
 }
@@ -244,10 +240,14 @@ struct Init_Section {
 //==============================================================================
 std::string day_14_a(char const * input_file_path)
 {
-    auto const input{ aoc::read_file(input_file_path) };
-    auto const init_sequence{ parse_init_sequence(input) };
+    auto const init_sequence{ parse_init_sequence(input_file_path) };
 
     Memory memory{};
+    memory.reserve(aoc::transform_reduce(
+        init_sequence,
+        size_t{},
+        [](Init_Section const & section) { return section.operations.size(); },
+        std::plus()));
     for (auto const & section : init_sequence) {
         for (auto const & operation : section.operations) {
             auto const masked_value{ section.mask.apply_part_a(operation.value) };
@@ -263,10 +263,17 @@ std::string day_14_a(char const * input_file_path)
 //==============================================================================
 std::string day_14_b(char const * input_file_path)
 {
-    auto const input{ aoc::read_file(input_file_path) };
-    auto const init_sequence{ parse_init_sequence(input) };
+    auto const init_sequence{ parse_init_sequence(input_file_path) };
 
+    // upper bound of the number of addresses, since later writes can overwrite earlier ones
     Memory memory{};
+    memory.reserve(aoc::transform_reduce(
+        init_sequence,
+        size_t{},
+        [](Init_Section const & section) {
+            return section.operations.size() * section.mask.get_number_of_floating_permutations();
+        },
+        std::plus()));
     std::vector<uint64_t> permutations;
 
     for (auto const & section : init_sequence) {
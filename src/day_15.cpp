@@ -59,6 +59,7 @@
 //
 // Given your starting numbers, what will be the 30000000th number spoken ?
 
+#include "HugePageAllocator.hpp"
 #include "utils.hpp"
 #include <resources.hpp>
 
@@ -72,7 +73,8 @@ std::string day_15(char const * input_file_path, size_t const how_many_turn_to_p
     auto const input{ aoc::read_file(input_file_path) };
     auto const starting_numbers{ aoc::StringView{ input }.parse_list<number_t>(',') };
 
-    std::vector<number_t> numbers{};
+    // turns at which each number was last said, read at random : on huge pages, the TLB covers the whole table
+    std::vector<number_t, aoc::Huge_Page_Allocator<number_t>> numbers{};
     numbers.resize(how_many_turn_to_play);
     number_t current_turn{ 1 };
     auto last_number{ starting_numbers.front() };
@@ -98,6 +98,11 @@
 //
 // Your puzzle answer was 953713095011.
 
+#include "BinaryCache.hpp"
+#include "BitSet.hpp"
+#include "Records.hpp"
+#include "SolverArena.hpp"
+#include "StructuralIndex.hpp"
 #include "utils.hpp"
 #include <resources.hpp>
 
@@ -118,6 +123,9 @@ struct Range {
     [[nodiscard]] constexpr bool contains(number_t const value) const { return value >= min && value <= max; }
 };
 
+//==============================================================================
+constexpr aoc::Scan_Format RULE_FORMAT{ "{}: {}-{} or {}-{}" };
+
 //==============================================================================
 struct Rule {
     std::string name;
@@ -148,12 +156,11 @@ struct Rule {
     [[nodiscard]] static Rule from_string(aoc::StringView const & line)
     {
         Rule result{};
-        line.scan("{}: {}-{} or {}-{}",
-                  result.name,
-                  result.low_range.min,
-                  result.low_range.max,
-                  result.high_range.min,
-                  result.high_range.max);
+        line.scan<RULE_FORMAT>(result.name,
+                               result.low_range.min,
+                               result.low_range.max,
+                               result.high_range.min,
+                               result.high_range.max);
         return result;
     }
 };
@@ -161,24 +168,45 @@ struct Rule {
 //==============================================================================
 [[nodiscard]] std::vector<Rule> parse_rules(aoc::StringView const & string)
 {
-    return string.iterate_transform(Rule::from_string, '\n');
+    return aoc::StructuralIndex{ string }.transform_lines_parallel(Rule::from_string);
 }
 
 //==============================================================================
-using Ticket = std::vector<number_t>;
+// Tickets are read in place, from the parsed fields or from the binary cache : they can't outlive either.
+using Ticket = aoc::Array_View<number_t>;
+using Tickets = std::pmr::vector<Ticket>;
+
+//==============================================================================
+// Cuts fields laid out ticket after ticket into tickets of number_of_fields fields.
+Tickets split_tickets(aoc::Array_View<number_t> const & fields,
+                      size_t const number_of_fields,
+                      std::pmr::memory_resource * resource)
+{
+    assert(number_of_fields > 0 && fields.size() % number_of_fields == 0);
+    Tickets result{ resource };
+    result.reserve(fields.size() / number_of_fields);
+    for (auto it{ fields.cbegin() }; it != fields.cend(); it += number_of_fields) {
+        result.emplace_back(it, number_of_fields);
+    }
+    return result;
+}
 
 //==============================================================================
-std::vector<Ticket> parse_tickets(aoc::StringView const string)
+// The first line of the record is its title. Every ticket's fields are appended to the same array.
+std::pmr::vector<number_t> parse_ticket_fields(aoc::Records::Record const & record,
+                                               std::pmr::memory_resource * resource)
 {
-    auto const lines{ string.split('\n') };
-    std::vector<Ticket> result{};
-    result.resize(lines.size());
-    aoc::transform(lines, result, [](aoc::StringView const & line) { return line.parse_list<number_t>(','); });
+    std::pmr::vector<number_t> result{ resource };
+    auto const lines{ record.lines() };
+    for (auto it{ std::next(lines.cbegin()) }; it != lines.cend(); ++it) {
+        auto const fields{ (*it).parse_list<number_t>(',', resource) };
+        result.insert(result.cend(), fields.cbegin(), fields.cend());
+    }
     return result;
 }
 
 //==============================================================================
-number_t get_ticket_scanning_error_rate(std::vector<Ticket> const & tickets, std::vector<Rule> const & rules)
+number_t get_ticket_scanning_error_rate(Tickets const & tickets, std::vector<Rule> const & rules)
 {
     auto const is_invalid_entry = [&](number_t const & value) {
         return aoc::all_of(rules, [&](Rule const & rule) { return !rule.contains(value); });
@@ -210,13 +238,13 @@ struct Solved_Field {
 };
 
 //==============================================================================
-std::vector<Solved_Field> deduce(std::vector<Ticket> const & tickets, std::vector<Rule> const & rules);
+std::vector<Solved_Field> deduce(Tickets const & tickets, std::vector<Rule> const & rules);
 
 //==============================================================================
 struct Day_16_Data {
     std::vector<Rule> rules;
     Ticket my_ticket;
-    std::vector<Ticket> nearby_tickets;
+    Tickets nearby_tickets;
     //==============================================================================
     [[nodiscard]] number_t get_departure_product() const
     {
@@ -251,24 +279,79 @@ struct Day_16_Data {
         return departure_rule_indexes;
     }
     //==============================================================================
-    static Day_16_Data from_string(aoc::StringView const & string)
+    static std::vector<Rule> rules_from_cache(aoc::BinaryReader & reader)
+    {
+        std::vector<Rule> result(reader.read<std::uint64_t>());
+        for (auto & rule : result) {
+            rule.name = reader.read_string().to_std_string();
+            rule.low_range = reader.read<Range>();
+            rule.high_range = reader.read<Range>();
+        }
+        return result;
+    }
+    //==============================================================================
+    // Nearby tickets are stored as a single array.
+    static void to_cache(aoc::BinaryWriter & writer,
+                         std::vector<Rule> const & rules,
+                         aoc::Array_View<number_t> const & my_ticket,
+                         aoc::Array_View<number_t> const & nearby_fields)
     {
-        aoc::StringView ticket_fields_string;
-        aoc::StringView my_ticket_values_string;
-        aoc::StringView nearby_tickets_values_string;
-        string.scan("{}\n\nyour ticket:\n{}\n\nnearby tickets:\n{}",
-                    ticket_fields_string,
-                    my_ticket_values_string,
-                    nearby_tickets_values_string);
-
-        return Day_16_Data{ parse_rules(ticket_fields_string),
-                            my_ticket_values_string.parse_list<number_t>(','),
-                            parse_tickets(nearby_tickets_values_string) };
+        writer.write(std::uint64_t{ rules.size() });
+        for (auto const & rule : rules) {
+            writer.write_string(rule.name);
+            writer.write(rule.low_range);
+            writer.write(rule.high_range);
+        }
+
+        writer.write_array(my_ticket.cbegin(), my_ticket.size());
+        writer.write_array(nearby_fields.cbegin(), nearby_fields.size());
     }
 };
 
 //==============================================================================
-std::vector<Ticket> remove_invalid_tickets(std::vector<Ticket> const & tickets, std::vector<Rule> const & rules)
+constexpr aoc::Cache_Schema CACHE_SCHEMA{ 16, 1 };
+
+//==============================================================================
+// Calls func with the data of the input, loaded from its binary cache when possible.
+template<typename Func>
+auto with_data(char const * input_file_path, Func const & func)
+{
+    auto * const resource{ aoc::solver_memory_resource() };
+
+    aoc::BinaryCache const cache{ input_file_path, CACHE_SCHEMA };
+    if (cache.is_loaded()) {
+        auto reader{ cache.reader() };
+        auto rules{ Day_16_Data::rules_from_cache(reader) };
+        auto const my_ticket{ reader.read_array<number_t>() };
+        auto nearby_tickets{ split_tickets(reader.read_array<number_t>(), my_ticket.size(), resource) };
+        return func(Day_16_Data{ std::move(rules), my_ticket, std::move(nearby_tickets) });
+    }
+
+    auto const input{ aoc::read_file(input_file_path) };
+    aoc::Records const records{ input };
+    assert(records.size() == 3);
+    auto const rules_record{ records.record(0) };
+    auto const my_ticket_record{ records.record(1) };
+    auto const nearby_tickets_record{ records.record(2) };
+    assert(my_ticket_record.num_lines() == 2 && my_ticket_record.line(0) == "your ticket:");
+    assert(nearby_tickets_record.line(0) == "nearby tickets:");
+
+    auto rules{ parse_rules(rules_record.string()) };
+    auto const my_ticket_fields{ my_ticket_record.line(1).parse_list<number_t>(',', resource) };
+    auto const nearby_fields{ parse_ticket_fields(nearby_tickets_record, resource) };
+    Ticket const my_ticket{ my_ticket_fields.data(), my_ticket_fields.size() };
+    aoc::Array_View<number_t> const nearby_fields_view{ nearby_fields.data(), nearby_fields.size() };
+
+    aoc::BinaryWriter writer{};
+    Day_16_Data::to_cache(writer, rules, my_ticket, nearby_fields_view);
+    cache.store(writer);
+
+    auto nearby_tickets{ split_tickets(nearby_fields_view, my_ticket.size(), resource) };
+    return func(Day_16_Data{ std::move(rules), my_ticket, std::move(nearby_tickets) });
+}
+
+//==============================================================================
+Tickets remove_invalid_tickets(Tickets const & tickets, std::vector<Rule> const & rules)
 {
     auto const is_valid_ticket = [&](Ticket const & ticket) {
         auto const is_valid_field = [&](number_t const & number) {
@@ -278,14 +361,14 @@ std::vector<Ticket> remove_invalid_tickets(std::vector<Ticket> const & tickets,
         return aoc::all_of(ticket, is_valid_field);
     };
 
-    std::vector<Ticket> valid_tickets{};
+    Tickets valid_tickets{ tickets.get_allocator() };
     valid_tickets.reserve(tickets.size());
     std::copy_if(std::cbegin(tickets), std::cend(tickets), std::back_inserter(valid_tickets), is_valid_ticket);
     return valid_tickets;
 }
 
 //==============================================================================
-std::vector<number_t> collect_field_samples(std::vector<Ticket> const & tickets, size_t const index)
+std::vector<number_t> collect_field_samples(Tickets const & tickets, size_t const index)
 {
     std::vector<number_t> field_samples{};
     field_samples.reserve(tickets.size());
@@ -303,20 +386,21 @@ std::vector<number_t> collect_field_samples(std::vector<Ticket> const & tickets,
 //==============================================================================
 struct Unsolved_Field {
     std::vector<number_t> samples;
-    std::vector<size_t> rule_index_candidates;
+    aoc::Bit_Set rule_index_candidates;
 };
 
 //==============================================================================
-std::vector<Unsolved_Field> construct_unsolved_fields(std::vector<Ticket> const & tickets)
+std::vector<Unsolved_Field> construct_unsolved_fields(Tickets const & tickets)
 {
     std::vector<Unsolved_Field> unsolved_fields{};
     assert(!tickets.empty());
     auto const number_of_fields{ tickets.front().size() };
     assert(aoc::all_of(tickets, [&](Ticket const & ticket) { return ticket.size() == number_of_fields; }));
     unsolved_fields.reserve(number_of_fields);
-    auto const index_list{ build_index_list(number_of_fields) };
+    aoc::Bit_Set all_rule_indexes{ number_of_fields };
+    all_rule_indexes.set_all();
     for (size_t field_index{}; field_index < number_of_fields; ++field_index) {
-        unsolved_fields.emplace_back(Unsolved_Field{ collect_field_samples(tickets, field_index), index_list });
+        unsolved_fields.emplace_back(Unsolved_Field{ collect_field_samples(tickets, field_index), all_rule_indexes });
     }
     return unsolved_fields;
 }
@@ -334,23 +418,21 @@ size_t register_solved_rule(size_t const solved_rule_index,
             continue;
         }
         auto & rule_index_candidates{ unsolved_fields[field_index].rule_index_candidates };
-        if (rule_index_candidates.size() == 1) {
+        if (rule_index_candidates.count() == 1) {
             // already solved
             continue;
         }
 
-        auto const rule_index_to_erase{ aoc::find(rule_index_candidates, solved_rule_index) };
-
-        if (rule_index_to_erase == std::cend(rule_index_candidates)) {
+        if (!rule_index_candidates.test(solved_rule_index)) {
             // nothing to erase
             continue;
         }
 
-        rule_index_candidates.erase(rule_index_to_erase);
+        rule_index_candidates.reset(solved_rule_index);
 
-        if (rule_index_candidates.size() == 1) {
+        if (rule_index_candidates.count() == 1) {
             number_of_solved_fields
-                += register_solved_rule(rule_index_candidates.front(), field_index, unsolved_fields);
+                += register_solved_rule(rule_index_candidates.find_first(), field_index, unsolved_fields);
         }
     }
 
@@ -358,7 +440,7 @@ size_t register_solved_rule(size_t const solved_rule_index,
 }
 
 //==============================================================================
-std::vector<Solved_Field> deduce(std::vector<Ticket> const & tickets, std::vector<Rule> const & rules)
+std::vector<Solved_Field> deduce(Tickets const & tickets, std::vector<Rule> const & rules)
 {
     auto const valid_tickets{ remove_invalid_tickets(tickets, rules) };
     auto unsolved_fields{ construct_unsolved_fields(valid_tickets) };
@@ -371,7 +453,7 @@ std::vector<Solved_Field> deduce(std::vector<Ticket> const & tickets, std::vecto
         for (size_t field_index{}; field_index < number_of_fields; ++field_index) {
             auto & unsolved_field{ unsolved_fields[field_index] };
 
-            if (unsolved_field.rule_index_candidates.size() == 1) {
+            if (unsolved_field.rule_index_candidates.count() == 1) {
                 // already solved
                 continue;
             }
@@ -382,17 +464,21 @@ std::vector<Solved_Field> deduce(std::vector<Ticket> const & tickets, std::vecto
             };
 
             auto & rule_index_candidates{ unsolved_field.rule_index_candidates };
-            aoc::remove_if(rule_index_candidates, is_invalid_rule_index_candidate);
-            if (rule_index_candidates.size() > 1) {
+            rule_index_candidates.iterate([&](size_t const rule_index_candidate) {
+                if (is_invalid_rule_index_candidate(rule_index_candidate)) {
+                    rule_index_candidates.reset(rule_index_candidate);
+                }
+            });
+            if (rule_index_candidates.count() > 1) {
                 // not solved yet
                 continue;
             }
             // solved
-            assert(rule_index_candidates.size() == 1);
+            assert(rule_index_candidates.count() == 1);
 
             // add to solved
             number_of_solved_fields
-                += register_solved_rule(rule_index_candidates.front(), field_index, unsolved_fields);
+                += register_solved_rule(rule_index_candidates.find_first(), field_index, unsolved_fields);
         }
     }
 
@@ -402,7 +488,7 @@ std::vector<Solved_Field> deduce(std::vector<Ticket> const & tickets, std::vecto
 
     for (size_t field_index{}; field_index < number_of_fields; ++field_index) {
         solved_fields.emplace_back(
-            Solved_Field{ unsolved_fields[field_index].rule_index_candidates.front(), field_index });
+            Solved_Field{ unsolved_fields[field_index].rule_index_candidates.find_first(), field_index });
     }
 
     return solved_fields;
@@ -413,9 +499,9 @@ std::vector<Solved_Field> deduce(std::vector<Ticket> const & tickets, std::vecto
 //==============================================================================
 std::string day_16_a(char const * input_file_path)
 {
-    auto const input{ aoc::read_file(input_file_path) };
-    auto const data{ Day_16_Data::from_string(input) };
-    auto const error_rate{ get_ticket_scanning_error_rate(data.nearby_tickets, data.rules) };
+    auto const error_rate{ with_data(input_file_path, [](Day_16_Data const & data) {
+        return get_ticket_scanning_error_rate(data.nearby_tickets, data.rules);
+    }) };
 
     return std::to_string(error_rate);
 }
@@ -423,9 +509,9 @@ std::string day_16_a(char const * input_file_path)
 //==============================================================================
 std::string day_16_b(char const * input_file_path)
 {
-    auto const input{ aoc::read_file(input_file_path) };
-    auto const data{ Day_16_Data::from_string(input) };
-    auto const departure_product{ data.get_departure_product() };
+    auto const departure_product{ with_data(input_file_path, [](Day_16_Data const & data) {
+        return data.get_departure_product();
+    }) };
 
     return std::to_string(departure_product);
 }
\ No newline at end of file
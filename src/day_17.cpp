@@ -63,6 +63,7 @@
 //
 // Your puzzle answer was 2264.
 
+#include "GridKernels.hpp"
 #include "utils.hpp"
 #include <resources.hpp>
 
@@ -219,12 +220,10 @@ private:
         static constexpr std::size_t MEDIAN_OFFSET{ Dimensions::neighbor_offsets[Dimensions::num_neighbors / 2] };
         static constexpr auto OFFSETS{ remove_value(Dimensions::neighbor_offsets, MEDIAN_OFFSET) };
 
-        auto const dest{ sum_matrix.begin() + MEDIAN_OFFSET };
+        auto * const dest{ sum_matrix.data() + MEDIAN_OFFSET };
 
         for (auto const offset : OFFSETS) {
-            auto const begin{ data.cbegin() + offset };
-            auto const end{ begin + AMOUNT_TO_COPY };
-            std::transform(begin, end, dest, dest, std::plus());
+            aoc::detail::add_cells(dest, data.data() + offset, AMOUNT_TO_COPY);
         }
         aoc::transform(data, sum_matrix, data, compute_state);
     }
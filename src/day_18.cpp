@@ -69,9 +69,13 @@
 //
 // What do you get if you add up the results of evaluating the homework problems using these new rules?
 
+#include "LineStream.hpp"
+#include "Pipeline.hpp"
 #include "utils.hpp"
 #include <resources.hpp>
 
+#include <memory>
+
 namespace
 {
 using number_t = uint64_t;
@@ -194,27 +198,31 @@ struct Expression {
             }
         }
 
-        std::sort(result.operators.begin(), result.operators.end(), sort_operator_ptrs);
+        std::stable_sort(result.operators.begin(), result.operators.end(), sort_operator_ptrs);
         return result;
     }
 };
 
+//==============================================================================
+template<typename OperatorPriorityFunc>
+number_t sum_of_expressions(char const * input_file_path, OperatorPriorityFunc const & operator_priority_func)
+{
+    aoc::LineStream stream{ input_file_path };
+    auto const solve_line = [&](aoc::StringView const & line) {
+        return Expression::parse(line, operator_priority_func).solve();
+    };
+    return aoc::make_pipeline(stream)
+        .transform(solve_line)
+        .reduce(aoc::execution::par, number_t{}, std::plus());
+}
+
 } // namespace
 
 //==============================================================================
 std::string day_18_a(char const * input_file_path)
 {
     static auto const get_op_priority = [](char) { return 0; };
-    static auto const parse_expression
-        = [](aoc::StringView const & line) { return Expression::parse(line, get_op_priority); };
-
-    auto const input{ aoc::read_file(input_file_path) };
-    auto expressions{ aoc::StringView{ input }.iterate_transform(parse_expression, '\n') };
-    auto const result{ std::transform_reduce(expressions.begin(),
-                                             expressions.end(),
-                                             number_t{},
-                                             std::plus(),
-                                             [](Expression & expression) { return expression.solve(); }) };
+    auto const result{ sum_of_expressions(input_file_path, get_op_priority) };
     return std::to_string(result);
 }
 
@@ -228,15 +236,6 @@ std::string day_18_b(char const * input_file_path)
         assert(c == '*');
         return 0;
     };
-    static auto const parse_expression
-        = [](aoc::StringView const & line) { return Expression::parse(line, get_op_priority); };
-
-    auto const input{ aoc::read_file(input_file_path) };
-    auto expressions{ aoc::StringView{ input }.iterate_transform(parse_expression, '\n') };
-    auto const result{ std::transform_reduce(expressions.begin(),
-                                             expressions.end(),
-                                             number_t{},
-                                             std::plus(),
-                                             [](Expression & expression) { return expression.solve(); }) };
+    auto const result{ sum_of_expressions(input_file_path, get_op_priority) };
     return std::to_string(result);
 }
\ No newline at end of file
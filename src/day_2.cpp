@@ -47,6 +47,8 @@
 //
 // How many passwords are valid according to the new interpretation of the policies ?
 
+#include "LineStream.hpp"
+#include "Pipeline.hpp"
 #include "StringView.hpp"
 #include "utils.hpp"
 
@@ -61,6 +63,9 @@ struct Password_Policy {
     int param_2; // for day_2_a it's max, for day_2_b it's index_2
 };
 
+//==============================================================================
+constexpr aoc::Scan_Format ENTRY_FORMAT{ "{}-{} {}: {}" };
+
 //==============================================================================
 struct Entry {
     Password_Policy password_policy;
@@ -69,11 +74,10 @@ struct Entry {
     static Entry from_string(aoc::StringView const & string)
     {
         Entry entry;
-        string.scan("{}-{} {}: {}",
-                    entry.password_policy.param_1,
-                    entry.password_policy.param_2,
-                    entry.password_policy.character,
-                    entry.password);
+        string.scan<ENTRY_FORMAT>(entry.password_policy.param_1,
+                                  entry.password_policy.param_2,
+                                  entry.password_policy.character,
+                                  entry.password);
 
         return entry;
     }
@@ -83,9 +87,11 @@ struct Entry {
 template<typename Pred>
 std::string day_2(char const * input_file_path, Pred const & predicate)
 {
-    auto const input{ aoc::read_file(input_file_path) };
-    auto const entries{ aoc::StringView{ input }.iterate_transform(Entry::from_string, '\n') };
-    auto const count{ aoc::count_if(entries, predicate) };
+    // entries point inside the stream's buffer : the pipeline checks each chunk before the next one is read
+    aoc::LineStream stream{ input_file_path };
+    auto const count{
+        aoc::make_pipeline(stream).transform(Entry::from_string).filter(predicate).count(aoc::execution::par)
+    };
 
     return std::to_string(count);
 }
@@ -128,6 +128,8 @@
 // Count the number of valid passports - those that have all required fields and valid values. Continue to treat cid as
 // optional. In your batch file, how many passports are valid ?
 
+#include "Needle.hpp"
+#include "Records.hpp"
 #include "StringView.hpp"
 #include "utils.hpp"
 #include <resources.hpp>
@@ -158,13 +160,16 @@ bool is_eyr_valid(aoc::StringView const & string)
 //==============================================================================
 bool is_hgt_valid(aoc::StringView const & string)
 {
-    auto const * cm_begin{ string.find("cm") };
+    static constexpr aoc::Needle CM{ "cm" };
+    static constexpr aoc::Needle IN{ "in" };
+
+    auto const * cm_begin{ CM.find_in(string) };
     if (cm_begin != string.cend()) {
         aoc::StringView const field{ string.cbegin(), cm_begin };
         auto const value{ field.parse<unsigned>() };
         return value >= 150 && value <= 193;
     }
-    auto const * in_begin{ string.find("in") };
+    auto const * in_begin{ IN.find_in(string) };
     if (in_begin == string.cend()) {
         return false;
     }
@@ -213,7 +218,7 @@ bool is_pid_valid(aoc::StringView const & string)
 
 //==============================================================================
 struct Constraint {
-    aoc::StringView id;
+    aoc::Needle id;
     bool (*validate)(aoc::StringView const &);
 };
 
@@ -227,24 +232,21 @@ constexpr std::array<Constraint, 7> CONSTRAINTS{ Constraint{ "byr:", is_byr_vali
 bool has_all_mandatory_fields(aoc::StringView const & entry)
 {
     return aoc::all_of(CONSTRAINTS, [&entry](Constraint const & constraint) -> bool {
-        return entry.find(constraint.id) != entry.cend();
+        return constraint.id.is_in(entry);
     });
 }
 
 //==============================================================================
 bool satisfies_constraint(aoc::StringView const & entry, Constraint const & constraint)
 {
-    static constexpr std::array<char, 2> STOP_CHARS{ ' ', '\n' };
+    static constexpr aoc::Char_Set STOP_CHARS{ " \n" };
 
-    auto const * stop_char_index{ entry.find(constraint.id) };
+    auto const * stop_char_index{ constraint.id.find_in(entry) };
     if (stop_char_index == entry.cend()) {
         return false;
     }
     auto const * const value_begin{ stop_char_index + constraint.id.size() };
-    auto const * const value_end{
-        std::find_first_of(value_begin, entry.cend(), STOP_CHARS.cbegin(), STOP_CHARS.cend())
-    };
-    aoc::StringView const value_string{ value_begin, value_end };
+    auto const value_string{ aoc::StringView{ value_begin, entry.cend() }.up_to(STOP_CHARS) };
     return constraint.validate(value_string);
 }
 
@@ -254,14 +256,15 @@ bool satisfies_constraint(aoc::StringView const & entry, Constraint const & cons
 std::string day_4_a(char const * input_file_path)
 {
     auto const input{ aoc::read_file(input_file_path) };
-    auto const entries{ aoc::split(input, "\n\n") };
+    aoc::Records const entries{ input.view() };
 
-    static auto constexpr is_entry_valid = [](aoc::StringView const & entry) -> bool {
+    static auto constexpr is_entry_valid = [](aoc::Records::Record const & record) -> bool {
+        auto const entry{ record.string() };
         return aoc::all_of(CONSTRAINTS,
-                           [&entry](Constraint const & constraint) -> bool { return entry.contains(constraint.id); });
+                           [&entry](Constraint const & constraint) -> bool { return constraint.id.is_in(entry); });
     };
 
-    auto const valid_count{ aoc::count_if(entries, is_entry_valid) };
+    auto const valid_count{ aoc::count_if(aoc::execution::par, entries, is_entry_valid) };
     return std::to_string(valid_count);
 }
 
@@ -269,14 +272,15 @@ std::string day_4_a(char const * input_file_path)
 std::string day_4_b(char const * input_file_path)
 {
     auto const input{ aoc::read_file(input_file_path) };
-    auto const entries{ aoc::split(input, "\n\n") };
+    aoc::Records const entries{ input.view() };
 
-    static auto constexpr is_entry_valid = [](aoc::StringView const & entry) -> bool {
+    static auto constexpr is_entry_valid = [](aoc::Records::Record const & record) -> bool {
+        auto const entry{ record.string() };
         return aoc::all_of(CONSTRAINTS, [&entry](Constraint const & constraint) -> bool {
             return satisfies_constraint(entry, constraint);
         });
     };
 
-    auto const valid_count{ aoc::count_if(entries, is_entry_valid) };
+    auto const valid_count{ aoc::count_if(aoc::execution::par, entries, is_entry_valid) };
     return std::to_string(valid_count);
 }
\ No newline at end of file
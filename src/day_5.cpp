@@ -58,6 +58,8 @@
 //
 // What is the ID of your seat ?
 
+#include "LineStream.hpp"
+#include "Pipeline.hpp"
 #include "utils.hpp"
 #include <resources.hpp>
 
@@ -86,21 +88,18 @@ using seat_id_t = int;
 //==============================================================================
 std::string day_5_a(char const * input_file_path)
 {
-    auto const input{ aoc::read_file(input_file_path) };
-    auto const ids{ aoc::StringView{ input }.iterate_transform(get_id, '\n') };
-    auto const max_id{ *aoc::max_element(ids) };
+    aoc::LineStream stream{ input_file_path };
+    auto const max_id{ aoc::make_pipeline(stream).transform(get_id).max(aoc::execution::par) };
+    assert(max_id);
 
-    return std::to_string(max_id);
+    return std::to_string(*max_id);
 }
 
 //==============================================================================
 std::string day_5_b(char const * input_file_path)
 {
-    auto const input{ aoc::read_file(input_file_path) };
-    auto const lines{ aoc::split(input, '\n') };
-    std::vector<seat_id_t> ids{};
-    ids.resize(lines.size());
-    aoc::transform(lines, ids, get_id);
+    aoc::LineStream stream{ input_file_path };
+    auto ids{ aoc::make_pipeline(stream).transform(get_id).collect(aoc::execution::par) };
     aoc::sort(ids);
 
     // TODO : adjacent something
@@ -80,15 +80,16 @@
 //
 // For each group, count the number of questions to which everyone answered "yes".What is the sum of those counts ?
 
+#include "Records.hpp"
 #include "utils.hpp"
 #include <resources.hpp>
 
 namespace
 {
 //==============================================================================
-auto get_unique_answers(aoc::StringView const & group)
+auto get_unique_answers(aoc::Records::Record const & group)
 {
-    auto group_copy{ group.to_std_string() };
+    auto group_copy{ group.string().to_std_string() };
     aoc::sort(group_copy);
     auto const first_alpha_char{ aoc::find_if(group_copy, [](char const & character) { return character != '\n'; }) };
     auto const unique_end{ std::unique(first_alpha_char, group_copy.end()) };
@@ -97,12 +98,12 @@ auto get_unique_answers(aoc::StringView const & group)
 }
 
 //==============================================================================
-auto get_consensus_answers(aoc::StringView const & group)
+auto get_consensus_answers(aoc::Records::Record const & group)
 {
-    auto const persons{ aoc::split(group, '\n') };
-    auto const & candidates{ persons.front() };
+    auto const persons{ group.lines() };
+    auto const candidates{ group.line(0) };
     auto const every_person_has_candidate = [&persons](char const candidate) {
-        return std::all_of(persons.cbegin() + 1, persons.cend(), [candidate](aoc::StringView const & person) {
+        return std::all_of(std::next(persons.cbegin()), persons.cend(), [candidate](aoc::StringView const & person) {
             return person.contains(candidate);
         });
     };
@@ -116,7 +117,7 @@ auto get_consensus_answers(aoc::StringView const & group)
 std::string day_6_a(char const * input_file_path)
 {
     auto const input{ aoc::read_file(input_file_path) };
-    auto const groups{ aoc::split(input, "\n\n") };
+    aoc::Records const groups{ input.view() };
     auto const sum_of_group_sums{
         aoc::transform_reduce(groups, std::string::difference_type(0), get_unique_answers, std::plus())
     };
@@ -127,7 +128,7 @@ std::string day_6_a(char const * input_file_path)
 std::string day_6_b(char const * input_file_path)
 {
     auto const input{ aoc::read_file(input_file_path) };
-    auto const groups{ aoc::split(input, "\n\n") };
+    aoc::Records const groups{ input.view() };
     auto const sum_of_group_sums{
         aoc::transform_reduce(groups, std::string::difference_type(0), get_consensus_answers, std::plus())
     };
@@ -70,9 +70,13 @@
 //
 // How many individual bags are required inside your single shiny gold bag ?
 
+#include <memory_resource>
 #include <optional>
-#include <set>
 
+#include "BinaryCache.hpp"
+#include "BitSet.hpp"
+#include "FlatStringMap.hpp"
+#include "SolverArena.hpp"
 #include "utils.hpp"
 #include <resources.hpp>
 
@@ -86,38 +90,47 @@ struct Color_Ownership {
     unsigned quantity;
 };
 
-constexpr size_t MAX_OWNED = 4;
-constexpr size_t MAX_OWNERS = 32;
+// Most bags hold a handful of colors and are held by a handful : longer lists go to the heap.
+constexpr size_t INLINE_OWNED = 4;
+constexpr size_t INLINE_OWNERS = 4;
 
 struct Color_Info {
     color_id_t id;
-    aoc::Static_Vector<Color_Ownership<color_id_t>, MAX_OWNED> colors_contained_by_me;
-    aoc::Static_Vector<Color_Ownership<color_id_t>, MAX_OWNERS> colors_that_contain_me;
+    aoc::Small_Vector<Color_Ownership<color_id_t>, INLINE_OWNED> colors_contained_by_me;
+    aoc::Small_Vector<Color_Ownership<color_id_t>, INLINE_OWNERS> colors_that_contain_me;
 };
 
+// What the cache stores, since Color_Info isn't trivially copyable.
+struct Ownership_Edge {
+    color_id_t owner;
+    color_id_t owned;
+    unsigned quantity;
+};
+
+//==============================================================================
+constexpr aoc::Scan_Format RULE_FORMAT{ "{} bags contain {}." };
+constexpr aoc::Scan_Format CONTAINED_BAGS_FORMAT{ "{} {} bag" };
+
 struct Rule {
     aoc::StringView color;
-    aoc::Static_Vector<Color_Ownership<aoc::StringView>, MAX_OWNED> owned_colors;
+    aoc::Small_Vector<Color_Ownership<aoc::StringView>, INLINE_OWNED> owned_colors;
     //==============================================================================
     static Rule from_string(aoc::StringView const & string)
     {
         Rule rule;
         aoc::StringView leftover;
-        string.scan("{} bags contain {}.", rule.color, leftover);
+        string.scan<RULE_FORMAT>(rule.color, leftover);
 
         if (leftover == "no other bags") {
             return rule;
         }
 
-        aoc::Static_Vector<aoc::StringView, MAX_OWNED> contained_strings;
-
-        leftover.iterate([&](aoc::StringView const & element) { contained_strings.push_back(element); }, ", ");
-
-        for (auto const & contained_string : contained_strings) {
+        auto const add_owned_color = [&](aoc::StringView const & contained_string) {
             Color_Ownership<aoc::StringView> ownership;
-            contained_string.scan("{} {} bag", ownership.quantity, ownership.color);
+            contained_string.scan<CONTAINED_BAGS_FORMAT>(ownership.quantity, ownership.color);
             rule.owned_colors.push_back(ownership);
-        }
+        };
+        leftover.iterate(add_owned_color, ", ");
 
         return rule;
     }
@@ -126,8 +139,8 @@ struct Rule {
 //==============================================================================
 class Color_Graph
 {
-    std::unordered_map<aoc::StringView, color_id_t> m_color_names_to_color_ids{};
-    std::vector<Color_Info> m_color_infos;
+    aoc::FlatStringMap<color_id_t> m_color_names_to_color_ids;
+    std::pmr::vector<Color_Info> m_color_infos;
     color_id_t m_next_id{};
 
 public:
@@ -141,32 +154,70 @@ public:
     Color_Graph & operator=(Color_Graph const &) = default;
     Color_Graph & operator=(Color_Graph &&) = default;
     //==============================================================================
-    Color_Graph(aoc::StringView const & input)
+    // Everything is allocated from resource, as well as the temporary containers of the queries.
+    Color_Graph(aoc::StringView const & input, std::pmr::memory_resource * resource)
+        : m_color_names_to_color_ids(resource)
+        , m_color_infos(resource)
     {
-        auto const lines{ split(input, '\n') };
+        for (auto const & line : input.lines()) {
+            add_rule(Rule::from_string(line));
+        }
+    }
+    //==============================================================================
+    // The color names point into the cache, which must outlive the graph.
+    static Color_Graph from_cache(aoc::BinaryReader & reader, std::pmr::memory_resource * resource)
+    {
+        auto const number_of_colors{ reader.read<std::uint64_t>() };
+        aoc::FlatStringMap<color_id_t> color_names_to_color_ids{ resource };
+        color_names_to_color_ids.reserve(number_of_colors);
+        for (color_id_t id{}; id < number_of_colors; ++id) {
+            color_names_to_color_ids.try_emplace(reader.read_string(), id);
+        }
+        std::pmr::vector<Color_Info> color_infos{ resource };
+        color_infos.reserve(number_of_colors);
+        for (color_id_t id{}; id < number_of_colors; ++id) {
+            color_infos.push_back(Color_Info{ id, {}, {} });
+        }
 
-        std::vector<Rule> rules{};
-        rules.resize(lines.size());
-        aoc::transform(lines, rules, Rule::from_string);
+        Color_Graph graph{ std::move(color_names_to_color_ids), std::move(color_infos) };
+        for (auto const & edge : reader.read_array<Ownership_Edge>()) {
+            graph.add_ownership(edge.owner, edge.owned, edge.quantity);
+        }
+        return graph;
+    }
+    //==============================================================================
+    void to_cache(aoc::BinaryWriter & writer) const
+    {
+        std::pmr::vector<aoc::StringView> color_names{ resource() };
+        color_names.resize(m_color_infos.size());
+        m_color_names_to_color_ids.iterate(
+            [&](aoc::StringView const & name, color_id_t const id) { color_names[id] = name; });
+
+        writer.write(std::uint64_t{ color_names.size() });
+        for (auto const & color_name : color_names) {
+            writer.write_string(color_name);
+        }
 
-        for (auto const & rule : rules) {
-            add_rule(rule);
+        std::pmr::vector<Ownership_Edge> edges{ resource() };
+        for (auto const & owner : m_color_infos) {
+            for (auto const & owned : owner.colors_contained_by_me) {
+                edges.push_back(Ownership_Edge{ owner.id, owned.color, owned.quantity });
+            }
         }
+        writer.write_array(edges);
     }
     //==============================================================================
     size_t get_number_of_colors_that_contain_color(aoc::StringView const & target_name) const
     {
-        assert(m_color_names_to_color_ids.find(target_name) != m_color_names_to_color_ids.cend());
+        assert(m_color_names_to_color_ids.contains(target_name));
 
-        std::set<color_id_t> colors_that_own_target{};
+        aoc::Bit_Set colors_that_own_target{ m_color_infos.size(), resource() };
 
         std::function<void(color_id_t)> const register_owners
             = [this, &colors_that_own_target, &register_owners](color_id_t const target_id) {
                   for (auto const & owner : m_color_infos[target_id].colors_that_contain_me) {
-                      auto const emplace_result{ colors_that_own_target.emplace(owner.color) };
-                      if (emplace_result.second) {
-                          // insertion took place : new owner
-                          // register owners' owners
+                      if (!colors_that_own_target.test_and_set(owner.color)) {
+                          // new owner : register owners' owners
                           register_owners(owner.color);
                       }
                   }
@@ -174,15 +225,15 @@ public:
 
         auto const target_id{ m_color_names_to_color_ids.at(target_name) };
         register_owners(target_id);
-        return colors_that_own_target.size();
+        return colors_that_own_target.count();
     }
     //==============================================================================
     size_t get_number_of_bags_contained_by_color(aoc::StringView const & target_name) const
     {
-        assert(m_color_names_to_color_ids.find(target_name) != m_color_names_to_color_ids.cend());
+        assert(m_color_names_to_color_ids.contains(target_name));
         auto const target_id{ m_color_names_to_color_ids.at(target_name) };
 
-        std::vector<std::optional<unsigned>> bags_contained_in_colors{};
+        std::pmr::vector<std::optional<unsigned>> bags_contained_in_colors{ resource() };
         bags_contained_in_colors.resize(m_color_infos.size());
 
         std::function<void(color_id_t)> compute_number_of_bags_in_bag
@@ -204,6 +255,18 @@ public:
     }
 
 private:
+    //==============================================================================
+    Color_Graph(aoc::FlatStringMap<color_id_t> color_names_to_color_ids, std::pmr::vector<Color_Info> color_infos)
+        : m_color_names_to_color_ids(std::move(color_names_to_color_ids))
+        , m_color_infos(std::move(color_infos))
+        , m_next_id(aoc::narrow<color_id_t>(m_color_infos.size()))
+    {
+    }
+    //==============================================================================
+    [[nodiscard]] std::pmr::memory_resource * resource() const noexcept
+    {
+        return m_color_infos.get_allocator().resource();
+    }
     //==============================================================================
     void add_rule(Rule const & rule)
     {
@@ -211,14 +274,16 @@ private:
 
         // add each owned colors on each sides
         for (auto const & owned_color : rule.owned_colors) {
-            auto const owned_id{ get_or_add_color_id(owned_color.color) };
-            m_color_infos[owner_id].colors_contained_by_me.push_back(
-                Color_Ownership<color_id_t>{ owned_id, owned_color.quantity });
-            m_color_infos[owned_id].colors_that_contain_me.push_back(
-                Color_Ownership<color_id_t>{ owner_id, owned_color.quantity });
+            add_ownership(owner_id, get_or_add_color_id(owned_color.color), owned_color.quantity);
         }
     }
     //==============================================================================
+    void add_ownership(color_id_t const owner_id, color_id_t const owned_id, unsigned const quantity)
+    {
+        m_color_infos[owner_id].colors_contained_by_me.push_back(Color_Ownership<color_id_t>{ owned_id, quantity });
+        m_color_infos[owned_id].colors_that_contain_me.push_back(Color_Ownership<color_id_t>{ owner_id, quantity });
+    }
+    //==============================================================================
     color_id_t get_or_add_color_id(aoc::StringView const & color_name)
     {
         auto const emplace_result{ m_color_names_to_color_ids.try_emplace(color_name, m_next_id) };
@@ -226,30 +291,51 @@ private:
             // insertion took place : new color
             m_color_infos.emplace_back(Color_Info{ m_next_id++, {}, {} });
         }
-        return emplace_result.first->second;
+        return *emplace_result.first;
     }
 };
 
 constexpr aoc::StringView TARGET = "shiny gold";
 
-} // namespace
+constexpr aoc::Cache_Schema CACHE_SCHEMA{ 7, 2 };
 
 //==============================================================================
-std::string day_7_a(char const * input_file_path)
+// Calls func with the graph of the input, loaded from its binary cache when possible.
+template<typename Func>
+auto with_color_graph(char const * input_file_path, Func const & func)
 {
+    aoc::BinaryCache const cache{ input_file_path, CACHE_SCHEMA };
+    if (cache.is_loaded()) {
+        auto reader{ cache.reader() };
+        return func(Color_Graph::from_cache(reader, aoc::solver_memory_resource()));
+    }
+
     auto const input{ aoc::read_file(input_file_path) };
-    Color_Graph const graph{ input };
+    Color_Graph const graph{ input, aoc::solver_memory_resource() };
 
-    auto const result{ graph.get_number_of_colors_that_contain_color(TARGET) };
+    aoc::BinaryWriter writer{};
+    graph.to_cache(writer);
+    cache.store(writer);
+
+    return func(graph);
+}
+
+} // namespace
+
+//==============================================================================
+std::string day_7_a(char const * input_file_path)
+{
+    auto const result{ with_color_graph(input_file_path, [](Color_Graph const & graph) {
+        return graph.get_number_of_colors_that_contain_color(TARGET);
+    }) };
     return std::to_string(result);
 }
 
 //==============================================================================
 std::string day_7_b(char const * input_file_path)
 {
-    auto const input{ aoc::read_file(input_file_path) };
-    Color_Graph const graph{ input };
-
-    auto const result{ graph.get_number_of_bags_contained_by_color(TARGET) };
+    auto const result{ with_color_graph(input_file_path, [](Color_Graph const & graph) {
+        return graph.get_number_of_bags_contained_by_color(TARGET);
+    }) };
     return std::to_string(result);
 }
\ No newline at end of file
@@ -101,9 +101,14 @@
 // Fix the program so that it terminates normally by changing exactly one jmp(to nop) or nop(to jmp).What is the value
 // of the accumulator after the program terminates ?
 
+#include "BinaryCache.hpp"
+#include "BitSet.hpp"
+#include "LineStream.hpp"
 #include "utils.hpp"
 #include <resources.hpp>
 
+#include <optional>
+
 namespace
 {
 //==============================================================================
@@ -143,6 +148,9 @@ argument_t parse_argument(aoc::StringView const & string)
     return clean_string.parse<argument_t>();
 }
 
+//==============================================================================
+constexpr aoc::Scan_Format INSTRUCTION_FORMAT{ "{} {}" };
+
 //==============================================================================
 struct Instruction {
     Operation operation;
@@ -152,7 +160,7 @@ struct Instruction {
     {
         aoc::StringView operation_string;
         aoc::StringView argument_string;
-        line.scan("{} {}", operation_string, argument_string);
+        line.scan<INSTRUCTION_FORMAT>(operation_string, argument_string);
         auto const operation{ parse_operation(operation_string) };
         auto const argument{ parse_argument(argument_string) };
         Instruction const result{ operation, argument };
@@ -161,18 +169,44 @@ struct Instruction {
 };
 
 //==============================================================================
-using Memory = std::vector<Instruction>;
+// Read in place : either the instructions that were just parsed or the array inside the binary cache.
+using Memory = aoc::Array_View<Instruction>;
+
+//==============================================================================
+constexpr aoc::Cache_Schema CACHE_SCHEMA{ 8, 1 };
 
 //==============================================================================
-Memory parse_memory(aoc::StringView const & input)
+// Calls func with the instructions of the input, loaded from its binary cache when possible.
+template<typename Func>
+auto with_memory(char const * input_file_path, Func const & func)
 {
-    return input.iterate_transform(Instruction::from_string, '\n');
+    aoc::BinaryCache const cache{ input_file_path, CACHE_SCHEMA };
+    if (cache.is_loaded()) {
+        return func(cache.reader().read_array<Instruction>());
+    }
+
+    auto const instructions{ aoc::LineStream{ input_file_path }.iterate_transform_parallel(Instruction::from_string) };
+
+    aoc::BinaryWriter writer{};
+    writer.write_array(instructions);
+    cache.store(writer);
+
+    return func(Memory{ instructions.data(), instructions.size() });
+}
+
+//==============================================================================
+constexpr Operation swap_operation(Operation const operation) noexcept(!aoc::detail::IS_DEBUG)
+{
+    assert(operation == Operation::jmp || operation == Operation::nop);
+    return operation == Operation::jmp ? Operation::nop : Operation::jmp;
 }
 
 //==============================================================================
 class Console
 {
     Memory m_memory{};
+    // The memory is read-only : the corrupted instruction is swapped when it gets executed.
+    std::optional<size_t> m_patched_address{};
     argument_t m_accumulator{};
     size_t m_stack_pointer{};
 
@@ -180,15 +214,13 @@ public:
     //==============================================================================
     enum class Debug_Code { no_error, infinite_loop };
     //==============================================================================
-    explicit Console(Memory memory) noexcept : m_memory(std::move(memory)) {}
+    explicit Console(Memory const & memory) noexcept : m_memory(memory) {}
     //==============================================================================
     Debug_Code debug()
     {
-        std::vector<bool> visited_addresses{};
-        visited_addresses.resize(m_memory.size());
+        aoc::Bit_Set visited_addresses{ m_memory.size() };
 
-        while (m_stack_pointer < m_memory.size() && !visited_addresses[m_stack_pointer]) {
-            visited_addresses[m_stack_pointer] = true;
+        while (m_stack_pointer < m_memory.size() && !visited_addresses.test_and_set(m_stack_pointer)) {
             execute_instruction(m_memory[m_stack_pointer]);
         }
         assert(m_stack_pointer <= m_memory.size());
@@ -197,12 +229,6 @@ public:
     //==============================================================================
     void fix_corrupted_instruction() noexcept(!aoc::detail::IS_DEBUG)
     {
-        auto const swap_operations = [this](size_t const & address) {
-            auto & operation{ m_memory[address].operation };
-            assert(operation == Operation::jmp || operation == Operation::nop);
-            operation = (operation == Operation::jmp ? Operation::nop : Operation::jmp);
-        };
-
         auto const get_next_jmp_or_nop_address = [this](size_t stack_pointer) {
             while (m_memory[stack_pointer].operation != Operation::jmp
                    && m_memory[stack_pointer].operation != Operation::nop) {
@@ -211,13 +237,10 @@ public:
             return stack_pointer;
         };
 
-        auto debug_cursor{ get_next_jmp_or_nop_address(0) };
-        swap_operations(debug_cursor);
+        m_patched_address = get_next_jmp_or_nop_address(0);
         auto debug_code{ debug() };
         while (debug_code != Debug_Code::no_error) {
-            swap_operations(debug_cursor);
-            debug_cursor = get_next_jmp_or_nop_address(debug_cursor + 1);
-            swap_operations(debug_cursor);
+            m_patched_address = get_next_jmp_or_nop_address(*m_patched_address + 1);
             m_stack_pointer = 0;
             m_accumulator = 0;
             debug_code = debug();
@@ -230,7 +253,9 @@ private:
     //==============================================================================
     void execute_instruction(Instruction const & instruction)
     {
-        switch (instruction.operation) {
+        auto const operation{ m_stack_pointer == m_patched_address ? swap_operation(instruction.operation)
+                                                                   : instruction.operation };
+        switch (operation) {
         case Operation::acc:
             m_accumulator += instruction.argument;
             ++m_stack_pointer;
@@ -252,19 +277,21 @@ private:
 //==============================================================================
 std::string day_8_a(char const * input_file_path)
 {
-    auto const input{ aoc::read_file(input_file_path) };
-    Console console{ parse_memory(input) };
-    console.debug();
-    auto const accumulator_value{ console.get_accumulator_value() };
+    auto const accumulator_value{ with_memory(input_file_path, [](Memory const & memory) {
+        Console console{ memory };
+        console.debug();
+        return console.get_accumulator_value();
+    }) };
     return std::to_string(accumulator_value);
 }
 
 //==============================================================================
 std::string day_8_b(char const * input_file_path)
 {
-    auto const input{ aoc::read_file(input_file_path) };
-    Console console{ parse_memory(input) };
-    console.fix_corrupted_instruction();
-    auto const result{ console.get_accumulator_value() };
+    auto const result{ with_memory(input_file_path, [](Memory const & memory) {
+        Console console{ memory };
+        console.fix_corrupted_instruction();
+        return console.get_accumulator_value();
+    }) };
     return std::to_string(result);
 }
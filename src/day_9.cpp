@@ -94,8 +94,10 @@
 //
 // What is the encryption weakness in your XMAS - encrypted list of numbers ?
 
+#include <optional>
 #include <type_traits>
 
+#include "LineStream.hpp"
 #include "utils.hpp"
 #include <resources.hpp>
 
@@ -103,11 +105,14 @@ namespace
 {
 using number_t = size_t;
 
+//==============================================================================
+constexpr aoc::Scan_Format PREAMBLE_FORMAT{ "preamble: {}" };
+
 //==============================================================================
 size_t parse_preamble_size(aoc::StringView const & line)
 {
-    size_t preamble;
-    line.scan("preamble: {}", preamble);
+    size_t preamble{};
+    line.scan<PREAMBLE_FORMAT>(preamble);
     return preamble;
 }
 
@@ -137,59 +142,102 @@ bool is_sum_of_two_numbers_in_preamble(number_t const & number, It const preambl
 }
 
 //==============================================================================
-number_t find_intruder(std::vector<number_t> const & numbers, size_t const preamble_size)
+// Only keeps the last preamble_size numbers, so that the numbers can be streamed in.
+class Intruder_Detector
 {
-    auto preamble_begin{ numbers.cbegin() };
-    auto preamble_end{ numbers.cbegin() + preamble_size };
+    std::vector<number_t> m_window{};
+    std::vector<number_t> m_sorted_window{};
+    size_t m_oldest{};
+    size_t m_preamble_size;
 
-    std::vector<number_t> preamble{};
-    for (auto number_it{ preamble_end }; number_it != numbers.cend(); ++preamble_begin, ++preamble_end, ++number_it) {
-        preamble.clear();
-        preamble.assign(preamble_begin, preamble_end);
-        aoc::sort(preamble);
+public:
+    //==============================================================================
+    explicit Intruder_Detector(size_t const preamble_size) : m_preamble_size(preamble_size)
+    {
+        m_window.reserve(preamble_size);
+    }
+    //==============================================================================
+    [[nodiscard]] bool is_intruder(number_t const number)
+    {
+        if (m_preamble_size == 0) {
+            // no two numbers to add up
+            return true;
+        }
+        if (m_window.size() < m_preamble_size) {
+            m_window.push_back(number);
+            return false;
+        }
 
-        if (!is_sum_of_two_numbers_in_preamble(*number_it, preamble.cbegin(), preamble.cend())) {
-            return *number_it;
+        m_sorted_window.assign(m_window.cbegin(), m_window.cend());
+        aoc::sort(m_sorted_window);
+        if (!is_sum_of_two_numbers_in_preamble(number, m_sorted_window.cbegin(), m_sorted_window.cend())) {
+            return true;
         }
+
+        m_window[m_oldest] = number;
+        m_oldest = (m_oldest + 1) % m_preamble_size;
+        return false;
     }
-    assert(false);
-    return {};
+};
+
+//==============================================================================
+// Nothing when every number is valid.
+std::optional<number_t> find_intruder(std::vector<number_t> const & numbers, size_t const preamble_size)
+{
+    Intruder_Detector detector{ preamble_size };
+    auto const intruder{ aoc::find_if(numbers, [&](number_t const number) { return detector.is_intruder(number); }) };
+    if (intruder == numbers.cend()) {
+        return std::nullopt;
+    }
+    return *intruder;
 }
 
 //==============================================================================
-number_t find_weakness(number_t const intruder, std::vector<number_t> const & numbers)
+std::optional<number_t> find_intruder(aoc::LineStream & stream, size_t const preamble_size)
 {
-    // TODO : This is probably broken with some inputs since the numbers are not perfectly sorted.
+    Intruder_Detector detector{ preamble_size };
+    aoc::StringView line{};
+    while (stream.next(line)) {
+        auto const number{ line.parse<number_t>() };
+        if (detector.is_intruder(number)) {
+            return number;
+        }
+    }
+    return std::nullopt;
+}
 
-    enum class Direction { up, down };
+//==============================================================================
+// Nothing when the input is empty (an empty stdin, for instance).
+std::optional<size_t> parse_preamble_size(aoc::LineStream & stream)
+{
+    aoc::StringView preamble_string{};
+    if (!stream.next(preamble_string)) {
+        return std::nullopt;
+    }
+    return parse_preamble_size(preamble_string);
+}
 
+//==============================================================================
+// Nothing when no contiguous range of at least two numbers adds up to the intruder.
+std::optional<number_t> find_weakness(number_t const intruder, std::vector<number_t> const & numbers)
+{
+    // The numbers are never negative : growing the range at the back and shrinking it from the front visits every range
+    // that could add up to the intruder.
     auto small{ numbers.cbegin() };
-    auto big{ small + 1 };
-    auto direction{ Direction::up };
-    auto sum{ *small + *big };
-
-    while (true) {
-        if (sum < intruder) {
-            if (direction == Direction::up) {
-                sum += *++big;
-            } else {
-                sum -= *small++;
-                direction = Direction::up;
-            }
-        } else if (sum > intruder) {
-            if (direction == Direction::down) {
-                sum -= *big--;
-            } else {
-                sum -= *small++;
-                direction = Direction::down;
-            }
-        } else {
-            auto const smallest{ *std::min_element(small, big + 1) };
-            auto const biggest{ *std::max_element(small, big + 1) };
-            auto const result{ smallest + biggest };
-            return result;
+    number_t sum{};
+
+    for (auto big{ numbers.cbegin() }; big != numbers.cend(); ++big) {
+        sum += *big;
+        while (sum > intruder && small < big) {
+            sum -= *small++;
+        }
+        if (sum == intruder && small < big) {
+            auto const [smallest, biggest] = std::minmax_element(small, big + 1);
+            return *smallest + *biggest;
         }
     }
+
+    return std::nullopt;
 }
 
 } // namespace
@@ -197,34 +245,37 @@ number_t find_weakness(number_t const intruder, std::vector<number_t> const & nu
 //==============================================================================
 std::string day_9_a(char const * input_file_path)
 {
-    auto const input{ aoc::read_file(input_file_path) };
-    aoc::StringView const view{ input };
-
-    auto const * first_line_feed{ view.find('\n') };
-
-    aoc::StringView const numbers_string{ std::next(first_line_feed), view.cend() };
-    aoc::StringView const preamble_string{ view.cbegin(), first_line_feed };
-    auto const preamble_size{ parse_preamble_size(preamble_string) };
-    auto const numbers{ numbers_string.parse_list<number_t>('\n') };
-    auto const intruder{ find_intruder(numbers, preamble_size) };
+    // only the preamble window is kept in memory
+    aoc::LineStream stream{ input_file_path };
+    auto const preamble_size{ parse_preamble_size(stream) };
+    if (!preamble_size) {
+        return {};
+    }
+    auto const intruder{ find_intruder(stream, *preamble_size) };
+    if (!intruder) {
+        return {};
+    }
 
-    return std::to_string(intruder);
+    return std::to_string(*intruder);
 }
 
 //==============================================================================
 std::string day_9_b(char const * input_file_path)
 {
-    auto const input{ aoc::read_file(input_file_path) };
-    aoc::StringView const view{ input };
-
-    auto const * first_line_feed{ view.find('\n') };
-
-    aoc::StringView const numbers_string{ std::next(first_line_feed), view.cend() };
-    aoc::StringView const preamble_string{ view.cbegin(), first_line_feed };
-    auto const preamble_size{ parse_preamble_size(preamble_string) };
-    auto const numbers{ numbers_string.parse_list<number_t>('\n') };
-    auto const intruder{ find_intruder(numbers, preamble_size) };
-    auto const weakness{ find_weakness(intruder, numbers) };
+    aoc::LineStream stream{ input_file_path };
+    auto const preamble_size{ parse_preamble_size(stream) };
+    if (!preamble_size) {
+        return {};
+    }
+    auto const numbers{ stream.parse_list_parallel<number_t>() };
+    auto const intruder{ find_intruder(numbers, *preamble_size) };
+    if (!intruder) {
+        return {};
+    }
+    auto const weakness{ find_weakness(*intruder, numbers) };
+    if (!weakness) {
+        return {};
+    }
 
-    return std::to_string(weakness);
+    return std::to_string(*weakness);
 }
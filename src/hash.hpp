@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace aoc
+{
+namespace detail
+{
+//==============================================================================
+// Default secret of wyhash.
+static constexpr std::uint64_t HASH_SECRET[4]{ 0x2d358dccaa6c78a5ull,
+                                               0x8bb84b93962eacc9ull,
+                                               0x4b33a62ed433d4a3ull,
+                                               0x4d5a2da51de1aa47ull };
+
+//==============================================================================
+// Full 64 x 64 -> 128 bits product : low half in a, high half in b.
+inline void multiply_128(std::uint64_t & a, std::uint64_t & b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    auto const product{ static_cast<unsigned __int128>(a) * b };
+    a = static_cast<std::uint64_t>(product);
+    b = static_cast<std::uint64_t>(product >> 64);
+#else
+    auto const a_high{ a >> 32 };
+    auto const a_low{ a & 0xFFFFFFFF };
+    auto const b_high{ b >> 32 };
+    auto const b_low{ b & 0xFFFFFFFF };
+    auto const high_high{ a_high * b_high };
+    auto const high_low{ a_high * b_low };
+    auto const low_high{ a_low * b_high };
+    auto const low_low{ a_low * b_low };
+    auto const middle{ (low_low >> 32) + (high_low & 0xFFFFFFFF) + (low_high & 0xFFFFFFFF) };
+    a = (middle << 32) | (low_low & 0xFFFFFFFF);
+    b = high_high + (high_low >> 32) + (low_high >> 32) + (middle >> 32);
+#endif
+}
+
+//==============================================================================
+[[nodiscard]] inline std::uint64_t mix(std::uint64_t a, std::uint64_t b) noexcept
+{
+    multiply_128(a, b);
+    return a ^ b;
+}
+
+//==============================================================================
+[[nodiscard]] inline std::uint64_t read_8(unsigned char const * bytes) noexcept
+{
+    std::uint64_t result;
+    std::memcpy(&result, bytes, sizeof(result));
+    return result;
+}
+[[nodiscard]] inline std::uint64_t read_4(unsigned char const * bytes) noexcept
+{
+    std::uint32_t result;
+    std::memcpy(&result, bytes, sizeof(result));
+    return result;
+}
+
+} // namespace detail
+
+//==============================================================================
+// wyhash (final version 4) : 48 bytes per round of three independent 128 bits multiplications, and short keys (the
+// common case of names and identifiers) in a couple of overlapping loads without any loop.
+//
+// Not a cryptographic hash. Assumes a little-endian CPU, so values differ on big-endian ones.
+[[nodiscard]] inline std::uint64_t
+    hash_bytes(void const * data, std::size_t const size, std::uint64_t seed = 0) noexcept
+{
+    using detail::HASH_SECRET;
+    using detail::mix;
+    using detail::read_4;
+    using detail::read_8;
+
+    auto const * bytes{ static_cast<unsigned char const *>(data) };
+    seed ^= mix(seed ^ HASH_SECRET[0], HASH_SECRET[1]);
+
+    std::uint64_t a;
+    std::uint64_t b;
+    if (size <= 16) {
+        if (size >= 4) {
+            auto const middle_offset{ (size >> 3) << 2 };
+            a = (read_4(bytes) << 32) | read_4(bytes + middle_offset);
+            b = (read_4(bytes + size - 4) << 32) | read_4(bytes + size - 4 - middle_offset);
+        } else if (size > 0) {
+            a = (std::uint64_t{ bytes[0] } << 16) | (std::uint64_t{ bytes[size >> 1] } << 8) | bytes[size - 1];
+            b = 0;
+        } else {
+            a = 0;
+            b = 0;
+        }
+    } else {
+        auto remaining{ size };
+        if (remaining > 48) {
+            auto seed_1{ seed };
+            auto seed_2{ seed };
+            do {
+                seed = mix(read_8(bytes) ^ HASH_SECRET[1], read_8(bytes + 8) ^ seed);
+                seed_1 = mix(read_8(bytes + 16) ^ HASH_SECRET[2], read_8(bytes + 24) ^ seed_1);
+                seed_2 = mix(read_8(bytes + 32) ^ HASH_SECRET[3], read_8(bytes + 40) ^ seed_2);
+                bytes += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+            seed ^= seed_1 ^ seed_2;
+        }
+        while (remaining > 16) {
+            seed = mix(read_8(bytes) ^ HASH_SECRET[1], read_8(bytes + 8) ^ seed);
+            remaining -= 16;
+            bytes += 16;
+        }
+        // the last 16 bytes, possibly overlapping the previous round
+        a = read_8(bytes + remaining - 16);
+        b = read_8(bytes + remaining - 8);
+    }
+
+    a ^= HASH_SECRET[1];
+    b ^= seed;
+    detail::multiply_128(a, b);
+    return mix(a ^ HASH_SECRET[0] ^ size, b ^ HASH_SECRET[1]);
+}
+
+} // namespace aoc
@@ -1,22 +1,139 @@
+#include <cstring>
 #include <iostream>
+#include <string>
+#include <vector>
+
+#include "BatchLoader.hpp"
+#include "InputFile.hpp"
+#include "SolverArena.hpp"
 
 #include <resources.hpp>
 
+namespace
+{
 //==============================================================================
-// TODO : add some cleaner CLI options.
-int main(int argc, char const ** argv)
+void print_usage()
+{
+    std::cerr << "Usage : main [--day <number>[a|b]] [input]\n"
+                 "        main --day <number>[a|b] --batch <input>...\n"
+                 "  Without --day, every solver runs on its default input.\n"
+                 "  input is a file path, \"-\" for the standard input or \"fd:<n>\" for an open file descriptor.\n"
+                 "  Without input, the day's default file is read, never the standard input.\n"
+                 "  A stream is read once, as it comes in : it only feeds a single part (e.g. --day 9a -).\n"
+                 "  --batch loads every input concurrently and solves them as they come in.\n";
+}
+
+//==============================================================================
+// Every run gets its own arena, released as soon as the result is there.
+std::string solve(Day const & day, char const * path)
+{
+    aoc::SolverArena const arena{};
+    return day.solve(path);
+}
+
+//==============================================================================
+// "9" selects both parts of day 9, "9a" only the first one.
+std::vector<Day const *> select_days(std::string const & selection)
 {
-    auto const * const DAYS_TO_SKIP = &DAYS[29];
+    static constexpr auto NAME_PREFIX_SIZE = 4; // "day_"
 
-    // for now, lets just print all functions
+    std::vector<Day const *> result{};
     for (auto const & day : DAYS) {
-        // if (&day == DAYS_TO_SKIP) {
-        //    std::cout << "Skipping day " << day.name << "...\n\n";
-        //    continue;
-        //}
+        std::string const name{ day.name + NAME_PREFIX_SIZE };
+        auto const number{ name.substr(0, name.find('_')) };
+        auto const part{ name.back() };
+        if (selection == number || selection == number + part) {
+            result.push_back(&day);
+        }
+    }
+    return result;
+}
+
+//==============================================================================
+void solve_batch(std::vector<Day const *> const & days, std::vector<char const *> const & paths)
+{
+    std::vector<std::string> results(paths.size() * days.size());
+
+    aoc::BatchLoader const loader{};
+    loader.run(paths, [&](std::size_t const input_index, aoc::StringView const & contents) {
+        for (std::size_t day_index{}; day_index < days.size(); ++day_index) {
+            auto const * const path{ paths[input_index] };
+            aoc::PreloadedInput const preload{ path, contents };
+            results[input_index * days.size() + day_index] = solve(*days[day_index], path);
+        }
+    });
+
+    for (std::size_t input_index{}; input_index < paths.size(); ++input_index) {
+        for (std::size_t day_index{}; day_index < days.size(); ++day_index) {
+            std::cout << days[day_index]->name << " (" << paths[input_index] << "):\n\t"
+                      << results[input_index * days.size() + day_index] << "\n\n";
+        }
+    }
+}
+
+} // namespace
+
+//==============================================================================
+int main(int argc, char const ** argv)
+{
+    char const * day_selection{};
+    char const * input_file_path{};
+    std::vector<char const *> batch_paths{};
+
+    for (int i{ 1 }; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--day") == 0 && i + 1 < argc) {
+            day_selection = argv[++i];
+        } else if (std::strcmp(argv[i], "--batch") == 0 && input_file_path == nullptr && batch_paths.empty()) {
+            batch_paths.assign(argv + i + 1, argv + argc);
+            if (batch_paths.empty()) {
+                print_usage();
+                return 1;
+            }
+            break;
+        } else if (input_file_path == nullptr && std::strncmp(argv[i], "--", 2) != 0) {
+            input_file_path = argv[i];
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    if (day_selection == nullptr) {
+        if (input_file_path != nullptr || !batch_paths.empty()) {
+            // an input only makes sense for a given day
+            print_usage();
+            return 1;
+        }
+
+        for (auto const & day : DAYS) {
+            std::cout << day.name << ":\n\t" << solve(day, day.default_input_file_path) << "\n\n";
+        }
+
+        return 0;
+    }
+
+    auto const days{ select_days(day_selection) };
+    if (days.empty()) {
+        std::cerr << "Unknown day \"" << day_selection << "\".\n";
+        print_usage();
+        return 1;
+    }
+
+    if (!batch_paths.empty()) {
+        solve_batch(days, batch_paths);
+        return 0;
+    }
+
+    if (input_file_path != nullptr && aoc::InputFile::is_stream_path(input_file_path) && days.size() > 1) {
+        // keeping the whole stream around for the second part would defeat reading it as it comes in
+        std::cerr << "A stream can only be read once : select a single part (e.g. --day " << day_selection << "a).\n";
+        return 1;
+    }
 
-        std::cout << day.name << ":\n\t" << day.function() << "\n\n";
+    for (auto const * day : days) {
+        auto const * const path{ input_file_path != nullptr ? input_file_path : day->default_input_file_path };
+        std::cout << day->name << ":\n\t" << solve(*day, path) << "\n\n";
     }
 
     return 0;
-}
\ No newline at end of file
+}
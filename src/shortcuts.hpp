@@ -1,11 +1,62 @@
 #pragma once
 
+#include "SimdReduce.hpp"
+#include "ThreadPool.hpp"
+
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstdint>
+#include <functional>
+#include <iterator>
 #include <numeric>
+#include <optional>
+#include <type_traits>
+#include <vector>
 
 namespace aoc
 {
+namespace detail
+{
+//==============================================================================
+// The element type of collections with std::data() (arrays, vectors, strings), void for the others.
+template<typename Coll, typename = void>
+struct Contiguous_Element {
+    using type = void;
+};
+template<typename Coll>
+struct Contiguous_Element<Coll, std::void_t<decltype(std::data(std::declval<Coll const &>()))>> {
+    using type = std::remove_cv_t<std::remove_pointer_t<decltype(std::data(std::declval<Coll const &>()))>>;
+};
+template<typename Coll>
+using contiguous_element_t = typename Contiguous_Element<Coll>::type;
+
+//==============================================================================
+// Whether the kernels of SimdReduce.hpp can read T, as the unsigned integer of the same type.
+template<typename T>
+[[nodiscard]] constexpr bool is_simd_integer() noexcept
+{
+    if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+        using unsigned_t = std::make_unsigned_t<T>;
+        return std::is_same_v<unsigned_t, std::uint32_t> || std::is_same_v<unsigned_t, std::uint64_t>;
+    } else {
+        return false;
+    }
+}
+
+//==============================================================================
+template<typename T>
+[[nodiscard]] constexpr bool is_negative(T const value) noexcept
+{
+    if constexpr (std::is_signed_v<T>) {
+        return value < T{};
+    } else {
+        return false;
+    }
+}
+
+} // namespace detail
+
 template<typename It1, typename It2>
 [[nodiscard]] constexpr bool equal(It1 first1, It1 last1, It2 first2) noexcept
 {
@@ -35,10 +86,24 @@ void transform(In1 const & in1, In2 const & in2, Dest & dest, Fn const & fn)
     std::transform(in1.cbegin(), in1.cend(), in2.cbegin(), dest.begin(), fn);
 }
 
+// Sums of contiguous 32 and 64 bits integers go through detail::sum(), in 64 bits. The additions of std::reduce() wrap
+// around the same way, so converting the result to the type of init gives the same value.
 template<typename Coll, typename T, typename Fn>
 [[nodiscard]] auto reduce(Coll const & coll, T && init, Fn const & fn)
 {
-    return std::reduce(coll.cbegin(), coll.cend(), std::forward<T>(init), fn);
+    using element_t = detail::contiguous_element_t<Coll>;
+    using init_t = std::decay_t<T>;
+    if constexpr (detail::is_simd_integer<element_t>() && std::is_integral_v<init_t> && !std::is_same_v<init_t, bool>
+                  && (std::is_same_v<Fn, std::plus<>> || std::is_same_v<Fn, std::plus<init_t>>)) {
+        // 32 bits signed elements must be sign-extended, the others are summed as unsigned integers
+        using simd_t = std::conditional_t<std::is_signed_v<element_t> && sizeof(element_t) == 4,
+                                          std::int32_t,
+                                          std::make_unsigned_t<element_t>>;
+        auto const sum{ detail::sum(reinterpret_cast<simd_t const *>(std::data(coll)), std::size(coll)) };
+        return static_cast<init_t>(static_cast<std::uint64_t>(init) + static_cast<std::uint64_t>(sum));
+    } else {
+        return std::reduce(coll.cbegin(), coll.cend(), std::forward<T>(init), fn);
+    }
 }
 
 template<typename Coll, typename T, typename Transform_Fn, typename Reduce_Fn>
@@ -69,9 +134,25 @@ void sort(Coll & coll)
     std::sort(coll.begin(), coll.end());
 }
 
+// Contiguous 32 and 64 bits integers are compared a vector at a time (see detail::count_equal()).
 template<typename Coll, typename T>
 [[nodiscard]] auto count(Coll const & coll, T const & value)
 {
+    using element_t = detail::contiguous_element_t<Coll>;
+    if constexpr (detail::is_simd_integer<element_t>() && std::is_integral_v<T>) {
+        using difference_type = typename std::iterator_traits<decltype(coll.cbegin())>::difference_type;
+        using unsigned_t = std::make_unsigned_t<element_t>;
+        // values that don't survive the conversion are left to std::count() and its integer promotions
+        auto const element_value{ static_cast<element_t>(value) };
+        auto const is_kept{ static_cast<T>(element_value) == value
+                            && detail::is_negative(element_value) == detail::is_negative(value) };
+        if (is_kept) {
+            return static_cast<difference_type>(
+                detail::count_equal(reinterpret_cast<unsigned_t const *>(std::data(coll)),
+                                    std::size(coll),
+                                    static_cast<unsigned_t>(element_value)));
+        }
+    }
     return std::count(coll.cbegin(), coll.cend(), value);
 }
 
@@ -182,4 +263,229 @@ template<typename Coll, typename T>
     return std::find(coll.cbegin(), coll.cend(), value);
 }
 
+//==============================================================================
+// Execution policies of the overloads below.
+//
+// With par, the collection is cut in blocks of about PARALLEL_BLOCK_BYTES of elements, which run on
+// Thread_Pool::instance() : the functions are called concurrently, in no particular order, and reductions must be
+// associative. Collections that fit in a single block are handled on the calling thread.
+namespace execution
+{
+struct Sequenced_Policy {
+};
+struct Parallel_Policy {
+};
+inline constexpr Sequenced_Policy seq{};
+inline constexpr Parallel_Policy par{};
+
+} // namespace execution
+
+namespace detail
+{
+//==============================================================================
+// Blocks small enough to stay in L1 while they're processed.
+static constexpr std::size_t PARALLEL_BLOCK_BYTES = 32 * 1024;
+
+//==============================================================================
+// The first iterator of every block of [first, last), followed by last. Forward ranges are walked once.
+template<typename It>
+[[nodiscard]] std::vector<It> cut_in_blocks(It first, It const last)
+{
+    using value_type = typename std::iterator_traits<It>::value_type;
+    using difference_type = typename std::iterator_traits<It>::difference_type;
+    using category = typename std::iterator_traits<It>::iterator_category;
+    static constexpr auto BLOCK_SIZE{ static_cast<difference_type>(
+        std::max(PARALLEL_BLOCK_BYTES / sizeof(value_type), std::size_t{ 1 })) };
+
+    std::vector<It> bounds{ first };
+    while (first != last) {
+        if constexpr (std::is_base_of_v<std::random_access_iterator_tag, category>) {
+            first += std::min(BLOCK_SIZE, last - first);
+        } else {
+            for (difference_type i{}; i < BLOCK_SIZE && first != last; ++i) {
+                ++first;
+            }
+        }
+        bounds.push_back(first);
+    }
+    return bounds;
+}
+
+//==============================================================================
+// Calls block_func(block_first, block_last) for every block, on the thread pool.
+template<typename It, typename Block_Func>
+void for_each_block(It const first, It const last, Block_Func const & block_func)
+{
+    auto const bounds{ cut_in_blocks(first, last) };
+    Thread_Pool::instance().for_each_index(bounds.size() - 1,
+                                           [&](std::size_t const i) { block_func(bounds[i], bounds[i + 1]); });
+}
+
+//==============================================================================
+// transform_fn on every element, then reduce_fn on the results : blocks are reduced concurrently, then in order.
+template<typename It, typename T, typename Transform_Fn, typename Reduce_Fn>
+[[nodiscard]] T parallel_transform_reduce(It const first,
+                                          It const last,
+                                          T init,
+                                          Transform_Fn const & transform_fn,
+                                          Reduce_Fn const & reduce_fn)
+{
+    auto const bounds{ cut_in_blocks(first, last) };
+    std::vector<std::optional<T>> block_results(bounds.size() - 1);
+    Thread_Pool::instance().for_each_index(block_results.size(), [&](std::size_t const i) {
+        // blocks are never empty
+        auto it{ bounds[i] };
+        T block_result = transform_fn(*it);
+        for (++it; it != bounds[i + 1]; ++it) {
+            block_result = reduce_fn(std::move(block_result), transform_fn(*it));
+        }
+        block_results[i] = std::move(block_result);
+    });
+
+    for (auto & block_result : block_results) {
+        init = reduce_fn(std::move(init), std::move(*block_result));
+    }
+    return init;
+}
+
+//==============================================================================
+// Whether pred holds for any element. The remaining blocks are skipped once it does.
+template<typename It, typename Pred>
+[[nodiscard]] bool parallel_any_of(It const first, It const last, Pred const & pred)
+{
+    std::atomic<bool> is_found{};
+    for_each_block(first, last, [&](It const block_first, It const block_last) {
+        if (!is_found.load(std::memory_order_relaxed) && std::any_of(block_first, block_last, pred)) {
+            is_found.store(true, std::memory_order_relaxed);
+        }
+    });
+    return is_found.load();
+}
+
+} // namespace detail
+
+//==============================================================================
+template<typename Coll, typename T, typename Fn>
+[[nodiscard]] auto reduce(execution::Sequenced_Policy, Coll const & coll, T && init, Fn const & fn)
+{
+    return reduce(coll, std::forward<T>(init), fn);
+}
+template<typename Coll, typename T, typename Fn>
+[[nodiscard]] auto reduce(execution::Parallel_Policy, Coll const & coll, T && init, Fn const & fn)
+{
+    auto const identity = [](auto const & value) { return value; };
+    return detail::parallel_transform_reduce(coll.cbegin(), coll.cend(), std::decay_t<T>(init), identity, fn);
+}
+
+template<typename Coll, typename T, typename Transform_Fn, typename Reduce_Fn>
+[[nodiscard]] auto transform_reduce(execution::Sequenced_Policy,
+                                    Coll const & coll,
+                                    T && init,
+                                    Transform_Fn const & transform_fn,
+                                    Reduce_Fn const & reduce_fn)
+{
+    return transform_reduce(coll, std::forward<T>(init), transform_fn, reduce_fn);
+}
+template<typename Coll, typename T, typename Transform_Fn, typename Reduce_Fn>
+[[nodiscard]] auto transform_reduce(execution::Parallel_Policy,
+                                    Coll const & coll,
+                                    T && init,
+                                    Transform_Fn const & transform_fn,
+                                    Reduce_Fn const & reduce_fn)
+{
+    return detail::parallel_transform_reduce(coll.cbegin(),
+                                             coll.cend(),
+                                             std::decay_t<T>(init),
+                                             transform_fn,
+                                             reduce_fn);
+}
+
+template<typename Coll, typename Pred>
+[[nodiscard]] auto count_if(execution::Sequenced_Policy, Coll const & coll, Pred const & pred)
+{
+    return count_if(coll, pred);
+}
+template<typename Coll, typename Pred>
+[[nodiscard]] auto count_if(execution::Parallel_Policy, Coll const & coll, Pred const & pred)
+{
+    using difference_type = typename std::iterator_traits<decltype(coll.cbegin())>::difference_type;
+    return detail::parallel_transform_reduce(
+        coll.cbegin(),
+        coll.cend(),
+        difference_type{},
+        [&](auto const & element) { return pred(element) ? difference_type{ 1 } : difference_type{}; },
+        std::plus());
+}
+
+template<typename Coll, typename Pred>
+[[nodiscard]] bool all_of(execution::Sequenced_Policy, Coll const & coll, Pred const & pred)
+{
+    return all_of(coll, pred);
+}
+template<typename Coll, typename Pred>
+[[nodiscard]] bool all_of(execution::Parallel_Policy, Coll const & coll, Pred const & pred)
+{
+    return !detail::parallel_any_of(coll.cbegin(), coll.cend(), [&](auto const & element) { return !pred(element); });
+}
+
+template<typename Coll, typename Pred>
+[[nodiscard]] bool any_of(execution::Sequenced_Policy, Coll const & coll, Pred const & pred)
+{
+    return any_of(coll, pred);
+}
+template<typename Coll, typename Pred>
+[[nodiscard]] bool any_of(execution::Parallel_Policy, Coll const & coll, Pred const & pred)
+{
+    return detail::parallel_any_of(coll.cbegin(), coll.cend(), pred);
+}
+
+template<typename Coll, typename Pred>
+[[nodiscard]] bool none_of(execution::Sequenced_Policy, Coll const & coll, Pred const & pred)
+{
+    return none_of(coll, pred);
+}
+template<typename Coll, typename Pred>
+[[nodiscard]] bool none_of(execution::Parallel_Policy, Coll const & coll, Pred const & pred)
+{
+    return !detail::parallel_any_of(coll.cbegin(), coll.cend(), pred);
+}
+
+template<typename Coll, typename Fn>
+void for_each(execution::Sequenced_Policy, Coll & coll, Fn const & fn)
+{
+    for_each(coll, fn);
+}
+template<typename Coll, typename Fn>
+void for_each(execution::Parallel_Policy, Coll & coll, Fn const & fn)
+{
+    detail::for_each_block(std::begin(coll), std::end(coll), [&](auto const block_first, auto const block_last) {
+        std::for_each(block_first, block_last, fn);
+    });
+}
+
+template<typename Coll>
+void sort(execution::Sequenced_Policy, Coll & coll)
+{
+    sort(coll);
+}
+// Sorts the blocks, then merges pairs of sorted runs, twice as long every round.
+template<typename Coll>
+void sort(execution::Parallel_Policy, Coll & coll)
+{
+    auto const bounds{ detail::cut_in_blocks(coll.begin(), coll.end()) };
+    auto const num_blocks{ bounds.size() - 1 };
+    auto & pool{ Thread_Pool::instance() };
+    pool.for_each_index(num_blocks, [&](std::size_t const i) { std::sort(bounds[i], bounds[i + 1]); });
+
+    for (std::size_t run_size{ 1 }; run_size < num_blocks; run_size *= 2) {
+        auto const num_merges{ (num_blocks + 2 * run_size - 1) / (2 * run_size) };
+        pool.for_each_index(num_merges, [&](std::size_t const merge_index) {
+            auto const first{ merge_index * 2 * run_size };
+            auto const middle{ std::min(first + run_size, num_blocks) };
+            auto const last{ std::min(first + 2 * run_size, num_blocks) };
+            std::inplace_merge(bounds[first], bounds[middle], bounds[last]);
+        });
+    }
+}
+
 } // namespace aoc
@@ -1,15 +1,20 @@
 #pragma once
 
+#include "MappedFile.hpp"
 #include "StringView.hpp"
 
 #include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace aoc
 {
 //==============================================================================
-std::string read_file(char const * path);
+MappedFile read_file(char const * path);
 
 //==============================================================================
 template<typename Separator>
@@ -17,39 +22,157 @@ std::vector<aoc::StringView> split(StringView const & string, Separator const &
 {
     return string.split(separator);
 }
+template<typename Separator>
+std::pmr::vector<aoc::StringView>
+    split(StringView const & string, Separator const & separator, std::pmr::memory_resource * resource)
+{
+    return string.split(separator, resource);
+}
 
 //==============================================================================
-template<typename T, size_t MAX_SIZE>
-class Static_Vector
+// A vector that keeps up to INLINE_CAPACITY elements inside itself, and moves them to the heap past that.
+//
+// Sized for the common case instead of the worst one : small lists cost no allocation, and long ones still fit.
+// Elements must be trivially copyable, so growing, copying and moving are plain memcpy, and moving from a spilled
+// vector only steals its pointer.
+template<typename T, std::size_t INLINE_CAPACITY>
+class Small_Vector
 {
-    std::array<T, MAX_SIZE> m_data;
-    size_t m_size{};
+    static_assert(std::is_trivially_copyable_v<T>, "Small_Vector relocates its elements with memcpy.");
+    static_assert(INLINE_CAPACITY > 0);
 
-    static_assert(std::is_trivially_destructible<T>::value, "Static_Vector value type must be trivially destructible.");
+    std::uint32_t m_size{};
+    std::uint32_t m_capacity{ INLINE_CAPACITY }; // INLINE_CAPACITY : the elements are in m_inline_elements
+    union {
+        T * m_heap_elements;
+        alignas(T) unsigned char m_inline_elements[INLINE_CAPACITY * sizeof(T)];
+    };
 
 public:
     //==============================================================================
     using value_type = T;
+    using iterator = T *;
+    using const_iterator = T const *;
     //==============================================================================
-    [[nodiscard]] auto begin() noexcept { return m_data.begin(); }
-    [[nodiscard]] auto end() noexcept { return m_data.begin() + m_size; }
-    [[nodiscard]] auto begin() const noexcept { return m_data.begin(); }
-    [[nodiscard]] auto end() const noexcept { return m_data.begin() + m_size; }
-    [[nodiscard]] auto cbegin() const noexcept { return m_data.cbegin(); }
-    [[nodiscard]] auto cend() const noexcept { return m_data.cbegin() + m_size; }
+    Small_Vector() noexcept {}
+    ~Small_Vector() { free_heap_elements(); }
     //==============================================================================
-    T & push_back(T const & new_element) noexcept(!detail::IS_DEBUG)
+    Small_Vector(Small_Vector const & other) { append(other.cbegin(), other.cend()); }
+    Small_Vector(Small_Vector && other) noexcept { steal(other); }
+    Small_Vector & operator=(Small_Vector const & other)
     {
-        assert(m_size < MAX_SIZE);
-        return m_data[m_size++] = new_element;
+        if (this != &other) {
+            clear();
+            append(other.cbegin(), other.cend());
+        }
+        return *this;
     }
-    T & push_back(T && new_element) noexcept(!detail::IS_DEBUG)
+    Small_Vector & operator=(Small_Vector && other) noexcept
     {
-        assert(m_size < MAX_SIZE);
-        return m_data[m_size++] = std::forward<T>(new_element);
+        if (this != &other) {
+            free_heap_elements();
+            steal(other);
+        }
+        return *this;
     }
     //==============================================================================
-    [[nodiscard]] size_t size() const noexcept { return m_size; }
+    [[nodiscard]] T * data() noexcept
+    {
+        return is_inline() ? reinterpret_cast<T *>(m_inline_elements) : m_heap_elements;
+    }
+    [[nodiscard]] T const * data() const noexcept
+    {
+        return is_inline() ? reinterpret_cast<T const *>(m_inline_elements) : m_heap_elements;
+    }
+    //==============================================================================
+    [[nodiscard]] iterator begin() noexcept { return data(); }
+    [[nodiscard]] iterator end() noexcept { return data() + m_size; }
+    [[nodiscard]] const_iterator begin() const noexcept { return data(); }
+    [[nodiscard]] const_iterator end() const noexcept { return data() + m_size; }
+    [[nodiscard]] const_iterator cbegin() const noexcept { return data(); }
+    [[nodiscard]] const_iterator cend() const noexcept { return data() + m_size; }
+    //==============================================================================
+    [[nodiscard]] T & operator[](std::size_t const index) noexcept(!detail::IS_DEBUG)
+    {
+        assert(index < m_size);
+        return data()[index];
+    }
+    [[nodiscard]] T const & operator[](std::size_t const index) const noexcept(!detail::IS_DEBUG)
+    {
+        assert(index < m_size);
+        return data()[index];
+    }
+    //==============================================================================
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_capacity; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] bool is_inline() const noexcept { return m_capacity == INLINE_CAPACITY; }
+    //==============================================================================
+    void reserve(std::size_t const capacity)
+    {
+        if (capacity <= m_capacity) {
+            return;
+        }
+        assert(capacity <= std::numeric_limits<std::uint32_t>::max());
+        auto * const new_elements{ std::allocator<T>{}.allocate(capacity) };
+        std::memcpy(static_cast<void *>(new_elements), data(), m_size * sizeof(T));
+        free_heap_elements();
+        m_heap_elements = new_elements;
+        m_capacity = static_cast<std::uint32_t>(capacity);
+    }
+    //==============================================================================
+    T & push_back(T const & new_element)
+    {
+        if (m_size == m_capacity) {
+            // new_element might be one of ours : copy it before growing
+            auto const copy{ new_element };
+            grow_for(m_size + 1);
+            return data()[m_size++] = copy;
+        }
+        return data()[m_size++] = new_element;
+    }
+    // Bulk copy of [first, last), with at most one reallocation.
+    template<typename Iterator>
+    void append(Iterator const first, Iterator const last)
+    {
+        auto const count{ static_cast<std::size_t>(std::distance(first, last)) };
+        grow_for(m_size + count);
+        std::copy(first, last, data() + m_size);
+        m_size += static_cast<std::uint32_t>(count);
+    }
+    //==============================================================================
+    // Keeps the capacity.
+    void clear() noexcept { m_size = 0; }
+
+private:
+    //==============================================================================
+    void grow_for(std::size_t const size)
+    {
+        if (size > m_capacity) {
+            reserve(std::max(size, std::size_t{ m_capacity } * 2));
+        }
+    }
+    //==============================================================================
+    void free_heap_elements() noexcept
+    {
+        if (!is_inline()) {
+            std::allocator<T>{}.deallocate(m_heap_elements, m_capacity);
+        }
+    }
+    //==============================================================================
+    // Leaves other empty and inline. Anything this owned must have been freed.
+    void steal(Small_Vector & other) noexcept
+    {
+        m_size = other.m_size;
+        m_capacity = other.m_capacity;
+        if (other.is_inline()) {
+            std::memcpy(m_inline_elements, other.m_inline_elements, m_size * sizeof(T));
+        } else {
+            m_heap_elements = other.m_heap_elements;
+        }
+        other.m_size = 0;
+        other.m_capacity = INLINE_CAPACITY;
+    }
 };
 
 } // namespace aoc
\ No newline at end of file
@@ -3,6 +3,44 @@
 
 #include <resources.hpp>
 
+#include "BatchLoader.hpp"
+#include "BinaryCache.hpp"
+#include "BitSet.hpp"
+#include "Cpu.hpp"
+#include "FlatMap.hpp"
+#include "FlatStringMap.hpp"
+#include "GridKernels.hpp"
+#include "HugePageAllocator.hpp"
+#include "InputFile.hpp"
+#include "LineStream.hpp"
+#include "MappedFile.hpp"
+#include "MpmcQueue.hpp"
+#include "Needle.hpp"
+#include "PaddedBuffer.hpp"
+#include "PerfCounter.hpp"
+#include "Pipeline.hpp"
+#include "Records.hpp"
+#include "SolverArena.hpp"
+#include "SpscQueue.hpp"
+#include "StructuralIndex.hpp"
+#include "ThreadPool.hpp"
+#include "utils.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+#if !defined(_WIN32)
+    #include <unistd.h>
+#endif
+
 //==============================================================================
 TEST_CASE("day_1_a")
 {
@@ -117,12 +155,17 @@ TEST_CASE("day_9_a")
 {
     REQUIRE(day_9_a(inputs::TEST_9_A_1) == "127");
     REQUIRE(day_9_a(inputs::DAY_9) == "21806024");
+    // nothing to check, and no previous numbers to add up
+    REQUIRE(day_9_a(inputs::TEST_EMPTY).empty());
+    REQUIRE(day_9_a(inputs::TEST_9_A_2) == "35");
 }
 
 TEST_CASE("day_9_b")
 {
     REQUIRE(day_9_b(inputs::TEST_9_A_1) == "62");
     REQUIRE(day_9_b(inputs::DAY_9) == "2986195");
+    REQUIRE(day_9_b(inputs::TEST_EMPTY).empty());
+    REQUIRE(day_9_b(inputs::TEST_9_A_2).empty());
 }
 
 //==============================================================================
@@ -280,6 +323,1116 @@ TEST_CASE("day_18_b")
     REQUIRE(day_18_b(inputs::DAY_18) == "472171581333710");
 }
 
+//==============================================================================
+TEST_CASE("StringView find and count")
+{
+    static_assert(aoc::StringView{ "abcabc" }.count('b') == 2);
+    static_assert(*aoc::StringView{ "abc" }.find('c') == 'c');
+
+    // every length and offset around the vector widths, compared against the scalar reference
+    std::string buffer{};
+    for (std::size_t i{}; i < 300; ++i) {
+        buffer.push_back(i % 7 == 0 ? '\n' : static_cast<char>('a' + i % 26));
+    }
+    for (std::size_t begin{}; begin < 70; ++begin) {
+        for (auto end{ begin }; end <= buffer.size(); ++end) {
+            aoc::StringView const view{ buffer.data() + begin, end - begin };
+            for (char const c : { '\n', 'z', '!' }) {
+                REQUIRE(view.find(c) == aoc::detail::find_char_scalar(view.cbegin(), view.cend(), c));
+                REQUIRE(view.count(c) == aoc::detail::count_char_scalar(view.cbegin(), view.cend(), c));
+            }
+        }
+    }
+}
+
+//==============================================================================
+TEST_CASE("Needle")
+{
+    static constexpr aoc::Needle BYR{ "byr:" };
+    static_assert(BYR.strategy() == aoc::Needle::Strategy::filtered);
+    static_assert(BYR.first_offset() == 0 && BYR.second_offset() == 1);
+    static_assert(*aoc::Needle{ "r:" }.find_in("byr:1937") == 'r');
+    static_assert(aoc::StringView{ "abcabd" }.find("abd") - aoc::StringView{ "abcabd" }.cbegin() == 3);
+
+    // partial matches everywhere, full matches close to the vector widths and at the very end
+    std::string buffer{};
+    for (std::size_t i{}; i < 200; ++i) {
+        buffer += i % 3 == 0 ? "ab" : "a";
+    }
+    buffer.replace(61, 4, "abcz");
+    buffer.replace(buffer.size() - 3, 3, "bcz");
+    for (aoc::StringView const needle_string : { "ab", "abc", "abcz", "bcz", "zz", "aab" }) {
+        aoc::Needle const needle{ needle_string };
+        for (std::size_t begin{}; begin < 70; ++begin) {
+            for (auto end{ begin }; end <= buffer.size(); end += 3) {
+                aoc::StringView const view{ buffer.data() + begin, end - begin };
+                auto const * const expected{
+                    std::search(view.cbegin(), view.cend(), needle_string.cbegin(), needle_string.cend())
+                };
+                REQUIRE(view.find(needle_string) == expected);
+                REQUIRE(needle.find_in(view) == expected);
+            }
+        }
+    }
+}
+
+//==============================================================================
+TEST_CASE("Char_Set")
+{
+    static constexpr aoc::Char_Set DELIMITERS{ ",: -" };
+    static_assert(DELIMITERS.contains(':') && !DELIMITERS.contains('a') && !aoc::Char_Set{}.contains('\0'));
+    static_assert(*aoc::StringView{ "ab-c:d" }.find(DELIMITERS) == '-');
+
+    // every byte value, with sets that fit the nibble tables and one that doesn't
+    std::string buffer(256 * 3, '\0');
+    for (std::size_t i{}; i < buffer.size(); ++i) {
+        buffer[i] = static_cast<char>(i * 37 % 256);
+    }
+    std::string const wide_set{ "\x01\x11\x21\x31\x41\x51\x61\x71\x81\x91\xA1" };
+    std::array<aoc::Char_Set, 3> const sets{ DELIMITERS,
+                                             aoc::Char_Set{ "\n\x7F\x80\xFF" },
+                                             aoc::Char_Set{ wide_set.c_str() } };
+    for (auto const & set : sets) {
+        for (std::size_t block{}; block + aoc::Char_Set::BLOCK_SIZE <= buffer.size(); block += 5) {
+            std::uint64_t expected{};
+            for (std::size_t i{}; i < aoc::Char_Set::BLOCK_SIZE; ++i) {
+                expected |= std::uint64_t{ set.contains(buffer[block + i]) } << i;
+            }
+            REQUIRE(set.match(buffer.data() + block) == expected);
+        }
+    }
+    REQUIRE(!aoc::Char_Set{ wide_set.c_str() }.has_nibble_tables());
+
+    // same tokens as a character by character split
+    std::string record{};
+    for (int i{}; i < 50; ++i) {
+        record += "key:" + std::to_string(i) + (i % 3 == 0 ? "\n" : " ") + (i % 7 == 0 ? "-" : "");
+    }
+    aoc::StringView const view{ record };
+    std::vector<std::string> expected{ "" };
+    for (auto const c : record) {
+        if (c == ' ' || c == '\n' || c == ':') {
+            expected.emplace_back();
+        } else {
+            expected.back() += c;
+        }
+    }
+    static constexpr aoc::Char_Set SEPARATORS{ " \n:" };
+    std::vector<std::string> tokens{};
+    view.iterate([&](aoc::StringView const & token) { tokens.push_back(token.to_std_string()); }, SEPARATORS);
+    REQUIRE(tokens == expected);
+    tokens.clear();
+    for (auto const & token : view.tokens(SEPARATORS)) {
+        tokens.push_back(token.to_std_string());
+    }
+    REQUIRE(tokens == expected);
+}
+
+//==============================================================================
+TEST_CASE("StringView tokens")
+{
+    auto const to_strings = [](auto const & range) {
+        std::vector<std::string> result{};
+        for (auto const & token : range) {
+            result.push_back(token.to_std_string());
+        }
+        return result;
+    };
+
+    // same elements as split()
+    for (aoc::StringView const string : { "a,bc,,d", "", ",", "abc", "a,b," }) {
+        auto const expected{ string.split(',') };
+        std::vector<std::string> expected_strings(expected.size());
+        aoc::transform(expected, expected_strings, [](aoc::StringView const & token) { return token.to_std_string(); });
+        REQUIRE(to_strings(string.tokens(',')) == expected_strings);
+    }
+
+    aoc::StringView const records{ "a\nb\n\nc\n\nd" };
+    REQUIRE(to_strings(records.tokens("\n\n")) == std::vector<std::string>{ "a\nb", "c", "d" });
+    REQUIRE(aoc::count_if(records.lines(), [](aoc::StringView const & line) { return line.empty(); }) == 2);
+}
+
+//==============================================================================
+TEST_CASE("StringView integer parsing")
+{
+    static_assert(aoc::detail::are_eight_digits(0x3837363534333231));
+    static_assert(!aoc::detail::are_eight_digits(0x3837363534333A31));
+    static_assert(aoc::detail::parse_eight_digits(0x3837363534333231) == 12345678);
+    REQUIRE(aoc::detail::load_little_endian_64("12345678") == 0x3837363534333231);
+
+    for (aoc::StringView const string : { "0", "7", "12345678", "123456789", "0000000012", "18446744073709551615" }) {
+        REQUIRE(string.parse<std::uint64_t>() == string.parse_checked<std::uint64_t>());
+    }
+    REQUIRE(aoc::StringView{ "-9223372036854775808" }.parse<std::int64_t>() == INT64_MIN);
+    REQUIRE(aoc::StringView{ "170cm" }.parse<unsigned>() == 170);
+    REQUIRE(aoc::StringView{ "-1234567890" }.parse<int>() == -1234567890);
+
+    // only the checked variant reports overflows
+    REQUIRE(!aoc::StringView{ "18446744073709551616" }.parse_checked<std::uint64_t>());
+    REQUIRE(!aoc::StringView{ "300" }.parse_checked<std::uint8_t>());
+    REQUIRE(!aoc::StringView{ "abc" }.parse_checked<int>());
+
+    REQUIRE(aoc::StringView{ "1,22,333333333,4" }.parse_list<std::uint32_t>(',')
+            == std::vector<std::uint32_t>{ 1, 22, 333333333, 4 });
+    REQUIRE(aoc::StringView{ "-5\n12345678901\n0" }.parse_list<std::int64_t>('\n')
+            == std::vector<std::int64_t>{ -5, 12345678901, 0 });
+}
+
+//==============================================================================
+TEST_CASE("StringView parallel parsing")
+{
+    // big enough to be cut in several parts, with empty elements on some of the cuts
+    std::string input{};
+    std::string numbers{};
+    for (int i{}; i < 100000; ++i) {
+        input += i % 1000 == 0 ? "\n" : std::to_string(i * 7) + '\n';
+        numbers += std::to_string(i * 7) + '\n';
+    }
+    input += "42";
+    numbers += "42";
+    aoc::StringView const view{ input };
+
+    for (std::size_t const max_parts : { 1, 2, 3, 7 }) {
+        auto const parts{ view.partition('\n', max_parts) };
+        REQUIRE(parts.size() <= max_parts);
+        std::vector<aoc::StringView> elements{};
+        for (auto const & part : parts) {
+            auto const part_elements{ part.split('\n') };
+            elements.insert(elements.end(), part_elements.cbegin(), part_elements.cend());
+        }
+        REQUIRE(elements == view.split('\n'));
+    }
+
+    auto const to_size = [](aoc::StringView const & string) { return string.size(); };
+    REQUIRE(view.iterate_transform_parallel(to_size, '\n', 4) == view.iterate_transform(to_size, '\n'));
+    REQUIRE(aoc::StringView{ numbers }.parse_list_parallel<std::uint64_t>('\n', 4)
+            == aoc::StringView{ numbers }.parse_list<std::uint64_t>('\n'));
+    REQUIRE(aoc::StringView{ "1,2,3" }.parse_list_parallel<int>(',', 4) == std::vector<int>{ 1, 2, 3 });
+}
+
+//==============================================================================
+namespace
+{
+constexpr aoc::Scan_Format TEST_FORMAT{ "<{}-{}> {} | {}" };
+}
+
+TEST_CASE("Scan_Format")
+{
+    static_assert(TEST_FORMAT.num_captures() == 4);
+    static_assert(TEST_FORMAT.literal(0).size == 1 && TEST_FORMAT.literal(4).size == 0);
+
+    int low;
+    int high;
+    aoc::StringView word;
+    std::string rest;
+    aoc::StringView const line{ "<12-345> word | a | b" };
+    line.scan<TEST_FORMAT>(low, high, word, rest);
+    REQUIRE(low == 12);
+    REQUIRE(high == 345);
+    REQUIRE(word == "word");
+    REQUIRE(rest == "a | b");
+
+    // same results as the runtime format
+    int runtime_low;
+    int runtime_high;
+    aoc::StringView runtime_word;
+    std::string runtime_rest;
+    line.scan("<{}-{}> {} | {}", runtime_low, runtime_high, runtime_word, runtime_rest);
+    REQUIRE(std::tie(runtime_low, runtime_high, runtime_word, runtime_rest) == std::tie(low, high, word, rest));
+}
+
+//==============================================================================
+TEST_CASE("StructuralIndex")
+{
+    // long enough to span several blocks, with a partial last one
+    std::string string{};
+    for (int i{}; i < 40; ++i) {
+        string += std::to_string(i) + ",a;b\n" + (i % 3 == 0 ? "\n" : "");
+    }
+    string += "\n\n\nend";
+
+    aoc::StructuralIndex const index{ string, ",;" };
+    aoc::StringView const view{ string };
+
+    auto const lines{ view.split('\n') };
+    REQUIRE(index.num_lines() == lines.size());
+    for (std::size_t i{}; i < lines.size(); ++i) {
+        REQUIRE(index.line(i) == lines[i]);
+    }
+
+    auto const records{ view.split(aoc::StringView{ "\n\n" }) };
+    REQUIRE(index.num_records() == records.size());
+    for (std::size_t i{}; i < records.size(); ++i) {
+        REQUIRE(index.record(i) == records[i]);
+    }
+
+    REQUIRE(index.delimiters().size() == view.count(',') + view.count(';'));
+    REQUIRE(std::all_of(index.delimiters().cbegin(), index.delimiters().cend(), [&](std::uint32_t const offset) {
+        return string[offset] == ',' || string[offset] == ';';
+    }));
+    auto const to_size = [](aoc::StringView const & line) { return line.size(); };
+    for (std::size_t const max_threads : { 1, 3, 64 }) {
+        REQUIRE(index.transform_lines_parallel(to_size, max_threads) == view.iterate_transform(to_size, '\n'));
+    }
+    // big enough to be split
+    std::string numbers{};
+    for (int i{}; i < 100000; ++i) {
+        numbers += std::to_string(i) + '\n';
+    }
+    REQUIRE(aoc::StructuralIndex{ numbers }.transform_lines_parallel(to_size, 4)
+            == aoc::StringView{ numbers }.iterate_transform(to_size, '\n'));
+}
+
+//==============================================================================
+TEST_CASE("Records")
+{
+    for (aoc::StringView const string : { "a\nb\n\nc", "\n\na\n\n\nb\nc\n\n", "", "single", "a\n\n\n\nb" }) {
+        aoc::Records const records{ string };
+        auto const expected{ string.split(aoc::StringView{ "\n\n" }) };
+        REQUIRE(records.size() == expected.size());
+
+        std::size_t index{};
+        for (auto const & record : records) {
+            REQUIRE(record.string() == expected[index]);
+            REQUIRE(records.record(index).string() == expected[index]);
+
+            auto const expected_lines{ expected[index].split('\n') };
+            REQUIRE(record.num_lines() == expected_lines.size());
+            REQUIRE(std::equal(record.lines().cbegin(), record.lines().cend(), expected_lines.cbegin()));
+            ++index;
+        }
+        REQUIRE(index == expected.size());
+    }
+}
+
+//==============================================================================
+TEST_CASE("MappedFile")
+{
+    aoc::MappedFile file{ inputs::TEST_1_A_1 };
+    REQUIRE(file.is_mapped());
+    REQUIRE(file.view() == "1721\n979\n366\n299\n675\n1456");
+
+    auto const moved{ std::move(file) };
+    REQUIRE(file.empty());
+    REQUIRE(moved.view().parse_list<int>('\n').size() == 6);
+}
+
+//==============================================================================
+TEST_CASE("PaddedBuffer")
+{
+    auto const buffer{ aoc::PaddedBuffer::from_file(inputs::TEST_1_A_1) };
+    auto const view{ buffer.view() };
+    REQUIRE(view == "1721\n979\n366\n299\n675\n1456");
+    REQUIRE(reinterpret_cast<std::uintptr_t>(view.cbegin()) % aoc::PaddedStringView::ALIGNMENT == 0);
+
+    auto const suffix{ view.remove_from_start(5) };
+    REQUIRE(suffix == "979\n366\n299\n675\n1456");
+    REQUIRE(std::all_of(suffix.cend(), suffix.cend() + aoc::PaddedStringView::PADDING, [](char const c) {
+        return c == '\0';
+    }));
+
+    auto moved_from{ aoc::PaddedBuffer::from_file(inputs::TEST_1_A_1) };
+    auto moved_to{ std::move(moved_from) };
+    REQUIRE(moved_to.view() == view);
+    REQUIRE(moved_from.data() == nullptr);
+    REQUIRE(moved_from.empty());
+    REQUIRE(moved_from.view().empty());
+
+    moved_from = std::move(moved_to);
+    REQUIRE(moved_from.view() == view);
+    REQUIRE(moved_to.data() == nullptr);
+    REQUIRE(moved_to.empty());
+}
+
+//==============================================================================
+TEST_CASE("InputFile")
+{
+    REQUIRE(aoc::InputFile::is_stream_path("-"));
+    REQUIRE(aoc::InputFile::is_stream_path("fd:3"));
+    REQUIRE(!aoc::InputFile::is_stream_path(inputs::TEST_1_A_1));
+
+    aoc::InputFile file{ inputs::TEST_1_A_1 };
+    REQUIRE(file.regular_file_size() == std::optional<std::size_t>{ 25 });
+
+    std::vector<char> buffer{};
+    file.read_all(buffer);
+    REQUIRE(buffer.size() == 25);
+}
+
+//==============================================================================
+TEST_CASE("LineStream")
+{
+    static std::vector<std::string> const EXPECTED{ "1721", "979", "366", "299", "675", "1456" };
+
+    // chunks smaller than a line force the buffer to grow
+    for (std::size_t const chunk_size : { 1, 4, 8, 1024 }) {
+        aoc::LineStream stream{ inputs::TEST_1_A_1, chunk_size };
+        std::vector<std::string> lines{};
+        stream.iterate([&](aoc::StringView const & line) { lines.push_back(line.to_std_string()); });
+        REQUIRE(lines == EXPECTED);
+    }
+
+    aoc::LineStream stream{ inputs::TEST_1_A_1, 8 };
+    aoc::StringView line;
+    REQUIRE(stream.next(line));
+    REQUIRE(line == "1721");
+    REQUIRE(stream.parse_list<int>() == std::vector<int>{ 979, 366, 299, 675, 1456 });
+    REQUIRE(!stream.next(line));
+
+    // the whole file fits : a single chunk, and then the stream is known to be over
+    aoc::LineStream whole_stream{ inputs::TEST_1_A_1 };
+    REQUIRE(!whole_stream.is_exhausted());
+    aoc::StringView chunk;
+    REQUIRE(whole_stream.next_chunk(chunk));
+    REQUIRE(chunk == "1721\n979\n366\n299\n675\n1456");
+    REQUIRE(whole_stream.is_exhausted());
+    REQUIRE(!whole_stream.next_chunk(chunk));
+}
+
+//==============================================================================
+#if !defined(_WIN32)
+TEST_CASE("Stream inputs")
+{
+    // more than a pipe holds, so that reading and writing overlap
+    static constexpr int COUNT = 100'000;
+    int fds[2]{};
+    REQUIRE(::pipe(fds) == 0);
+    std::thread writer{ [&] {
+        std::string text{};
+        for (int i{}; i < COUNT; ++i) {
+            text += std::to_string(i) + '\n';
+        }
+        for (std::size_t written{}; written < text.size();) {
+            auto const result{ ::write(fds[1], text.data() + written, text.size() - written) };
+            if (result <= 0) {
+                break;
+            }
+            written += static_cast<std::size_t>(result);
+        }
+        ::close(fds[1]);
+    } };
+
+    auto const path{ aoc::InputFile::FILE_DESCRIPTOR_PREFIX + std::to_string(fds[0]) };
+    REQUIRE(aoc::InputFile::is_stream_path(path.c_str()));
+    REQUIRE(!aoc::InputFile{ path.c_str() }.regular_file_size());
+    aoc::LineStream stream{ path.c_str(), 4096 };
+    REQUIRE(stream.parse_list<int>() == [] {
+        std::vector<int> expected(COUNT);
+        std::iota(expected.begin(), expected.end(), 0);
+        return expected;
+    }());
+    writer.join();
+    ::close(fds[0]);
+
+    // a solver reading a descriptor
+    auto const contents{ aoc::MappedFile{ inputs::TEST_9_A_1 }.view().to_std_string() };
+    REQUIRE(::pipe(fds) == 0);
+    REQUIRE(::write(fds[1], contents.data(), contents.size()) == static_cast<ssize_t>(contents.size()));
+    ::close(fds[1]);
+    REQUIRE(day_9_a((aoc::InputFile::FILE_DESCRIPTOR_PREFIX + std::to_string(fds[0])).c_str()) == "127");
+    ::close(fds[0]);
+}
+#endif
+
+//==============================================================================
+TEST_CASE("BatchLoader")
+{
+    std::vector<char const *> const paths{ inputs::TEST_1_A_1, inputs::DAY_9, "missing_file", inputs::DAY_18 };
+
+    for (auto const backend : { aoc::BatchLoader::Backend::automatic, aoc::BatchLoader::Backend::threads }) {
+        std::vector<std::string> contents(paths.size());
+        aoc::BatchLoader const loader{ backend, 2, 2 };
+        loader.run(paths, [&](std::size_t const index, aoc::StringView const & view) {
+            contents[index] = view.to_std_string();
+        });
+
+        REQUIRE(contents[0] == aoc::MappedFile{ inputs::TEST_1_A_1 }.view().to_std_string());
+        REQUIRE(contents[1] == aoc::MappedFile{ inputs::DAY_9 }.view().to_std_string());
+        REQUIRE(contents[2].empty());
+        REQUIRE(contents[3] == aoc::MappedFile{ inputs::DAY_18 }.view().to_std_string());
+    }
+
+#if !defined(_WIN32)
+    // streams only : io_uring has nothing to submit for them
+    for (auto const backend : { aoc::BatchLoader::Backend::io_uring, aoc::BatchLoader::Backend::threads }) {
+        std::vector<std::string> const texts{ "1\n2", "3\n4\n5" };
+        std::vector<int> read_ends{};
+        std::vector<std::string> fd_paths{};
+        for (auto const & text : texts) {
+            int fds[2]{};
+            REQUIRE(::pipe(fds) == 0);
+            REQUIRE(::write(fds[1], text.data(), text.size()) == static_cast<ssize_t>(text.size()));
+            ::close(fds[1]);
+            read_ends.push_back(fds[0]);
+            fd_paths.push_back(aoc::InputFile::FILE_DESCRIPTOR_PREFIX + std::to_string(fds[0]));
+        }
+        std::vector<char const *> stream_paths{};
+        for (auto const & fd_path : fd_paths) {
+            stream_paths.push_back(fd_path.c_str());
+        }
+
+        std::vector<std::string> contents(stream_paths.size());
+        aoc::BatchLoader const loader{ backend, 2, 2 };
+        loader.run(stream_paths, [&](std::size_t const index, aoc::StringView const & view) {
+            contents[index] = view.to_std_string();
+        });
+        REQUIRE(contents == texts);
+        for (auto const fd : read_ends) {
+            ::close(fd);
+        }
+    }
+#endif
+
+    std::string const contents{ "1\n2\n3" };
+    aoc::PreloadedInput const preload{ "not_on_disk", aoc::StringView{ contents.data(), contents.size() } };
+    REQUIRE(aoc::MappedFile{ "not_on_disk" }.view() == "1\n2\n3");
+}
+
+//==============================================================================
+TEST_CASE("Small_Vector")
+{
+    aoc::Small_Vector<int, 4> vector{};
+    REQUIRE(vector.empty());
+    for (int i{}; i < 4; ++i) {
+        vector.push_back(i);
+    }
+    REQUIRE(vector.is_inline());
+    REQUIRE(vector.capacity() == 4);
+
+    vector.push_back(vector[0]);
+    REQUIRE(!vector.is_inline());
+    REQUIRE(std::vector<int>(vector.cbegin(), vector.cend()) == std::vector<int>{ 0, 1, 2, 3, 0 });
+
+    std::vector<int> const bulk(100, 7);
+    vector.append(bulk.cbegin(), bulk.cend());
+    REQUIRE(vector.size() == 105);
+    REQUIRE(vector[104] == 7);
+
+    auto const copy{ vector };
+    auto const * const heap_elements{ vector.data() };
+    auto const moved{ std::move(vector) };
+    REQUIRE(moved.data() == heap_elements);
+    REQUIRE(vector.empty());
+    REQUIRE(vector.is_inline());
+    REQUIRE(std::equal(copy.cbegin(), copy.cend(), moved.cbegin(), moved.cend()));
+
+    aoc::Small_Vector<int, 4> small{};
+    small.push_back(42);
+    vector = small;
+    auto other{ std::move(small) };
+    REQUIRE(other.is_inline());
+    REQUIRE(other[0] == 42);
+    REQUIRE(vector.size() == 1);
+    REQUIRE(vector[0] == 42);
+}
+
+//==============================================================================
+TEST_CASE("Bit_Set")
+{
+    // enough words for the vectorized loops and their remainder
+    static constexpr std::size_t SIZE = 7 * 64 + 13;
+    aoc::Bit_Set a{ SIZE };
+    aoc::Bit_Set b{ SIZE };
+    std::vector<bool> expected_a(SIZE);
+    std::vector<bool> expected_b(SIZE);
+    for (std::size_t i{}; i < SIZE; ++i) {
+        if (i % 3 == 0) {
+            a.set(i);
+            expected_a[i] = true;
+        }
+        if (i % 5 == 0 || i > 400) {
+            REQUIRE(!b.test_and_set(i));
+            expected_b[i] = true;
+        }
+    }
+    REQUIRE(b.test_and_set(5));
+
+    auto const require_equal = [](aoc::Bit_Set const & set, std::vector<bool> const & expected) {
+        REQUIRE(set.count() == static_cast<std::size_t>(std::count(expected.cbegin(), expected.cend(), true)));
+        std::vector<std::size_t> indexes{};
+        set.iterate([&](std::size_t const index) { indexes.push_back(index); });
+        std::vector<std::size_t> expected_indexes{};
+        for (std::size_t i{}; i < expected.size(); ++i) {
+            REQUIRE(set.test(i) == expected[i]);
+            if (expected[i]) {
+                expected_indexes.push_back(i);
+            }
+        }
+        REQUIRE(indexes == expected_indexes);
+        REQUIRE(set.find_first() == (expected_indexes.empty() ? set.size() : expected_indexes.front()));
+    };
+    require_equal(a, expected_a);
+    require_equal(b, expected_b);
+
+    auto a_and_b{ a };
+    a_and_b &= b;
+    auto a_or_b{ a };
+    a_or_b |= b;
+    auto a_and_not_b{ a };
+    a_and_not_b.and_not(b);
+    std::vector<bool> expected_and(SIZE);
+    std::vector<bool> expected_or(SIZE);
+    std::vector<bool> expected_and_not(SIZE);
+    for (std::size_t i{}; i < SIZE; ++i) {
+        expected_and[i] = expected_a[i] && expected_b[i];
+        expected_or[i] = expected_a[i] || expected_b[i];
+        expected_and_not[i] = expected_a[i] && !expected_b[i];
+    }
+    require_equal(a_and_b, expected_and);
+    require_equal(a_or_b, expected_or);
+    require_equal(a_and_not_b, expected_and_not);
+
+    aoc::Bit_Set sparse{ SIZE };
+    REQUIRE(sparse.none());
+    REQUIRE(sparse.find_first() == SIZE);
+    sparse.set(SIZE - 1);
+    sparse.set(300);
+    REQUIRE(sparse.find_first() == 300);
+    REQUIRE(sparse.find_next(301) == SIZE - 1);
+    REQUIRE(sparse.find_next(SIZE) == SIZE);
+
+    // resetting bits while iterating skips them : 3 is reset by 0, 9 by 6...
+    std::vector<std::size_t> visited{};
+    a.iterate([&](std::size_t const index) {
+        visited.push_back(index);
+        if (index + 3 < SIZE) {
+            a.reset(index + 3);
+        }
+    });
+    std::vector<std::size_t> expected_visited{};
+    for (std::size_t i{}; i < SIZE; i += 6) {
+        expected_visited.push_back(i);
+    }
+    REQUIRE(visited == expected_visited);
+
+    a.set_all();
+    REQUIRE(a.count() == SIZE);
+    a.reset_all();
+    REQUIRE(a.none());
+}
+
+//==============================================================================
+TEST_CASE("hash_bytes")
+{
+    // reference values of wyhash final 4, with the index as seed
+    std::array<std::pair<aoc::StringView, std::uint64_t>, 7> const expected{
+        std::pair<aoc::StringView, std::uint64_t>{ "", 0x93228a4de0eec5a2 },
+        { "a", 0xc5bac3db178713c4 },
+        { "abc", 0xa97f2f7b1d9b3314 },
+        { "message digest", 0x786d1f1df3801df4 },
+        { "abcdefghijklmnopqrstuvwxyz", 0xdca5a8138ad37c87 },
+        { "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789", 0xb9e734f117cfaf70 },
+        { "12345678901234567890123456789012345678901234567890123456789012345678901234567890", 0x6cc5eab49a92d617 }
+    };
+    for (std::size_t i{}; i < expected.size(); ++i) {
+        auto const & [string, hash] = expected[i];
+        REQUIRE(aoc::hash_bytes(string.cbegin(), string.size(), i) == hash);
+    }
+}
+
+//==============================================================================
+TEST_CASE("FlatStringMap")
+{
+    std::vector<std::string> keys{};
+    for (int i{}; i < 1000; ++i) {
+        keys.push_back("color " + std::to_string(i * 13 % 700));
+    }
+
+    aoc::FlatStringMap<int> map{};
+    std::unordered_map<aoc::StringView, int> expected{};
+    REQUIRE(map.find("color 0") == nullptr);
+    for (std::size_t i{}; i < keys.size(); ++i) {
+        auto const value{ static_cast<int>(i) };
+        auto const result{ map.try_emplace(keys[i], value) };
+        auto const expected_result{ expected.try_emplace(keys[i], value) };
+        REQUIRE(result.second == expected_result.second);
+        REQUIRE(*result.first == expected_result.first->second);
+    }
+    REQUIRE(map.size() == expected.size());
+    for (auto const & [key, value] : expected) {
+        REQUIRE(map.at(key) == value);
+    }
+    REQUIRE(!map.contains("color 700"));
+    REQUIRE(!map.contains(""));
+
+    std::size_t num_iterated{};
+    map.iterate([&](aoc::StringView const & key, int const value) {
+        REQUIRE(expected.at(key) == value);
+        ++num_iterated;
+    });
+    REQUIRE(num_iterated == expected.size());
+}
+
+//==============================================================================
+TEST_CASE("Flat_Map")
+{
+    aoc::Flat_Map<std::uint64_t, std::uint64_t> map{};
+    std::unordered_map<std::uint64_t, std::uint64_t> expected{};
+    REQUIRE(map.find(0) == nullptr);
+    for (std::uint64_t i{}; i < 5000; ++i) {
+        // many keys differing only by their high bits
+        auto const key{ (i % 3000) << 36 | (i % 7) };
+        auto const result{ map.try_emplace(key, i) };
+        auto const expected_result{ expected.try_emplace(key, i) };
+        REQUIRE(result.second == expected_result.second);
+        REQUIRE(*result.first == expected_result.first->second);
+        map[key ^ 1] += i;
+        expected[key ^ 1] += i;
+    }
+    REQUIRE(map.size() == expected.size());
+    for (auto const & [key, value] : expected) {
+        REQUIRE(map.at(key) == value);
+    }
+    REQUIRE(!map.contains(std::uint64_t{ 1 } << 63));
+
+    std::uint64_t expected_sum{};
+    std::size_t num_iterated{};
+    map.iterate([&](std::uint64_t const key, std::uint64_t const value) {
+        REQUIRE(expected.at(key) == value);
+        expected_sum += value;
+        ++num_iterated;
+    });
+    REQUIRE(num_iterated == expected.size());
+    REQUIRE(map.sum_values() == expected_sum);
+
+    aoc::Flat_Map<int, int> reserved{};
+    reserved.reserve(1000);
+    auto const capacity{ reserved.capacity() };
+    for (int i{}; i < 1000; ++i) {
+        reserved[-i] = i;
+    }
+    REQUIRE(reserved.capacity() == capacity);
+    REQUIRE(reserved.at(-999) == 999);
+}
+
+//==============================================================================
+TEST_CASE("SolverArena")
+{
+    REQUIRE(aoc::solver_memory_resource() == std::pmr::get_default_resource());
+    {
+        aoc::SolverArena arena{};
+        auto * const resource{ arena.resource() };
+        REQUIRE(aoc::solver_memory_resource() == resource);
+        {
+            aoc::SolverArena nested{};
+            REQUIRE(aoc::solver_memory_resource() == nested.resource());
+        }
+        REQUIRE(aoc::solver_memory_resource() == resource);
+
+        aoc::StringView const list{ "12,-3,45,6" };
+        auto const numbers{ list.parse_list<int>(',', resource) };
+        REQUIRE(numbers == std::pmr::vector<int>{ { 12, -3, 45, 6 }, resource });
+        REQUIRE(numbers.get_allocator().resource() == resource);
+
+        auto const strings{ list.parse_list<std::string>(',', resource) };
+        REQUIRE(strings.size() == 4);
+        REQUIRE(strings.back() == "6");
+
+        auto const elements{ list.split(',', resource) };
+        REQUIRE(elements.size() == 4);
+        REQUIRE(elements[1] == "-3");
+        REQUIRE(elements.get_allocator().resource() == resource);
+
+        auto const sizes{ list.iterate_transform([](aoc::StringView const & element) { return element.size(); },
+                                                 aoc::StringView{ "," },
+                                                 resource) };
+        REQUIRE(sizes == std::pmr::vector<std::size_t>{ { 2, 2, 2, 1 }, resource });
+
+        aoc::FlatStringMap<int> map{ resource };
+        map.reserve(100);
+        REQUIRE(map.try_emplace(elements[0], 0).second);
+        REQUIRE(map.at("12") == 0);
+    }
+    REQUIRE(aoc::solver_memory_resource() == std::pmr::get_default_resource());
+}
+
+//==============================================================================
+TEST_CASE("Thread_Pool")
+{
+    aoc::Thread_Pool pool{ 4 };
+    REQUIRE(pool.num_threads() == 4);
+
+    static constexpr std::size_t COUNT = 1000;
+    std::vector<std::atomic<int>> calls(COUNT);
+    pool.for_each_index(COUNT, [&](std::size_t const i) { ++calls[i]; });
+    REQUIRE(std::all_of(calls.cbegin(), calls.cend(), [](std::atomic<int> const & num_calls) {
+        return num_calls.load() == 1;
+    }));
+
+    // tasks waiting for tasks of their own
+    std::atomic<std::size_t> num_inner_calls{};
+    pool.for_each_index(16, [&](std::size_t) {
+        pool.for_each_index(16, [&](std::size_t) { ++num_inner_calls; });
+    });
+    REQUIRE(num_inner_calls.load() == 16 * 16);
+
+    // a throwing call doesn't keep the others from running, and its exception reaches the caller
+    std::atomic<std::size_t> num_calls{};
+    REQUIRE_THROWS_AS(pool.for_each_index(64,
+                                          [&](std::size_t const i) {
+                                              ++num_calls;
+                                              if (i % 16 == 3) {
+                                                  throw std::runtime_error{ "task failed" };
+                                              }
+                                          }),
+                      std::runtime_error);
+    REQUIRE(num_calls.load() == 64);
+
+    std::atomic<bool> is_done{};
+    pool.submit([&] { is_done = true; });
+    while (!is_done) {
+        std::this_thread::yield();
+    }
+}
+
+//==============================================================================
+TEST_CASE("Parallel algorithms")
+{
+    // many blocks, and a last one that isn't full
+    std::vector<int> numbers(100'003);
+    std::mt19937 generator{ 42 };
+    std::uniform_int_distribution<int> distribution{ -1000, 1000 };
+    std::generate(numbers.begin(), numbers.end(), [&] { return distribution(generator); });
+
+    static auto constexpr IS_EVEN = [](int const number) { return number % 2 == 0; };
+    REQUIRE(aoc::count_if(aoc::execution::par, numbers, IS_EVEN) == aoc::count_if(numbers, IS_EVEN));
+    REQUIRE(aoc::count_if(aoc::execution::seq, numbers, IS_EVEN) == aoc::count_if(numbers, IS_EVEN));
+    REQUIRE(aoc::reduce(aoc::execution::par, numbers, std::int64_t{}, std::plus())
+            == aoc::reduce(numbers, std::int64_t{}, std::plus()));
+    static auto constexpr SQUARE = [](int const number) { return std::int64_t{ number } * number; };
+    REQUIRE(aoc::transform_reduce(aoc::execution::par, numbers, std::int64_t{ 7 }, SQUARE, std::plus())
+            == aoc::transform_reduce(numbers, std::int64_t{ 7 }, SQUARE, std::plus()));
+
+    static auto constexpr IS_SMALL = [](int const number) { return number >= -1000 && number <= 1000; };
+    REQUIRE(aoc::all_of(aoc::execution::par, numbers, IS_SMALL));
+    REQUIRE(!aoc::any_of(aoc::execution::par, numbers, std::not_fn(IS_SMALL)));
+    REQUIRE(aoc::none_of(aoc::execution::par, numbers, [](int const number) { return number > 1000; }));
+    REQUIRE(aoc::any_of(aoc::execution::par, numbers, [&](int const number) { return number == numbers[90'000]; }));
+
+    // forward iterators are walked instead of jumped over
+    std::list<int> const list(numbers.cbegin(), numbers.cend());
+    REQUIRE(aoc::count_if(aoc::execution::par, list, IS_EVEN) == aoc::count_if(numbers, IS_EVEN));
+
+    auto doubled{ numbers };
+    aoc::for_each(aoc::execution::par, doubled, [](int & number) { number *= 2; });
+    REQUIRE(doubled[100'002] == 2 * numbers[100'002]);
+
+    auto expected{ numbers };
+    std::sort(expected.begin(), expected.end());
+    aoc::sort(aoc::execution::par, numbers);
+    REQUIRE(numbers == expected);
+
+    std::vector<int> empty{};
+    REQUIRE(aoc::count_if(aoc::execution::par, empty, IS_EVEN) == 0);
+    REQUIRE(aoc::all_of(aoc::execution::par, empty, IS_EVEN));
+    aoc::sort(aoc::execution::par, empty);
+}
+
+//==============================================================================
+TEST_CASE("Spsc_Queue")
+{
+    aoc::Spsc_Queue<int> queue{ 4 };
+    REQUIRE(queue.capacity() == 4);
+    int value{};
+    REQUIRE(!queue.try_pop(value));
+    for (int i{}; i < 4; ++i) {
+        REQUIRE(queue.try_push(i));
+    }
+    REQUIRE(!queue.try_push(4));
+    REQUIRE(queue.try_pop(value));
+    REQUIRE(value == 0);
+    REQUIRE(queue.try_push(4));
+
+    // values come out in order, across many rounds of the ring
+    static constexpr int COUNT = 100'000;
+    aoc::Spsc_Queue<int> link{ 64 };
+    std::thread producer{ [&] {
+        for (int i{}; i < COUNT; ++i) {
+            while (!link.try_push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    } };
+    bool is_in_order{ true };
+    for (int expected{}; expected < COUNT; ++expected) {
+        while (!link.try_pop(value)) {
+            std::this_thread::yield();
+        }
+        is_in_order = is_in_order && value == expected;
+    }
+    producer.join();
+    REQUIRE(is_in_order);
+    REQUIRE(!link.try_pop(value));
+}
+
+//==============================================================================
+TEST_CASE("Mpmc_Queue")
+{
+    static constexpr int NUM_THREADS = 4;
+    static constexpr int COUNT_PER_PRODUCER = 50'000;
+
+    aoc::Mpmc_Queue<int> queue{ 128 };
+    std::atomic<int> num_popped{};
+    std::atomic<std::int64_t> sum{};
+    std::vector<std::thread> threads{};
+    for (int thread{}; thread < NUM_THREADS; ++thread) {
+        threads.emplace_back([&] {
+            for (int i{ 1 }; i <= COUNT_PER_PRODUCER; ++i) {
+                while (!queue.try_push(i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        threads.emplace_back([&] {
+            std::int64_t local_sum{};
+            int value{};
+            while (num_popped.load() < NUM_THREADS * COUNT_PER_PRODUCER) {
+                if (queue.try_pop(value)) {
+                    local_sum += value;
+                    ++num_popped;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            sum += local_sum;
+        });
+    }
+    for (auto & thread : threads) {
+        thread.join();
+    }
+    REQUIRE(num_popped.load() == NUM_THREADS * COUNT_PER_PRODUCER);
+    REQUIRE(sum.load() == std::int64_t{ NUM_THREADS } * COUNT_PER_PRODUCER * (COUNT_PER_PRODUCER + 1) / 2);
+    int value{};
+    REQUIRE(!queue.try_pop(value));
+}
+
+//==============================================================================
+TEST_CASE("Pipeline")
+{
+    std::vector<int> numbers(100'003);
+    std::mt19937 generator{ 50 };
+    std::uniform_int_distribution<int> distribution{ -1000, 1000 };
+    std::generate(numbers.begin(), numbers.end(), [&] { return distribution(generator); });
+
+    static auto constexpr IS_EVEN = [](int const number) { return number % 2 == 0; };
+    static auto constexpr SQUARE = [](int const number) { return std::int64_t{ number } * number; };
+    auto const expected_count{ aoc::count_if(numbers, IS_EVEN) };
+    std::int64_t expected_sum{};
+    std::vector<std::int64_t> expected_squares{};
+    for (auto const number : numbers) {
+        if (IS_EVEN(number)) {
+            expected_sum += SQUARE(number);
+            expected_squares.push_back(SQUARE(number));
+        }
+    }
+    auto const expected_max{ *std::max_element(expected_squares.cbegin(), expected_squares.cend()) };
+
+    // the shared pool may have a single thread : a pool with workers makes sure the stages run concurrently
+    aoc::Thread_Pool pool{ 4 };
+    auto const pipeline = [&] { return aoc::make_pipeline(numbers).on(pool).filter(IS_EVEN).transform(SQUARE); };
+    REQUIRE(pipeline().count() == static_cast<std::size_t>(expected_count));
+    REQUIRE(pipeline().count(aoc::execution::par) == static_cast<std::size_t>(expected_count));
+    REQUIRE(pipeline().reduce(std::int64_t{ 7 }, std::plus()) == expected_sum + 7);
+    REQUIRE(pipeline().reduce(aoc::execution::par, std::int64_t{ 7 }, std::plus()) == expected_sum + 7);
+    REQUIRE(pipeline().max() == expected_max);
+    REQUIRE(pipeline().max(aoc::execution::par) == expected_max);
+    REQUIRE(pipeline().collect() == expected_squares);
+    auto squares{ pipeline().collect(aoc::execution::par) };
+    std::sort(squares.begin(), squares.end());
+    std::sort(expected_squares.begin(), expected_squares.end());
+    REQUIRE(squares == expected_squares);
+
+    // forward iterators, and an rvalue source moved into the pipeline
+    std::string text{};
+    for (std::size_t i{}; i < 10'000; ++i) {
+        text += std::to_string(numbers[i]) + '\n';
+    }
+    text.pop_back();
+    auto const line_count{ aoc::make_pipeline(aoc::StringView{ text }.lines())
+                               .on(pool)
+                               .transform([](aoc::StringView const & line) { return line.parse<int>(); })
+                               .filter(IS_EVEN)
+                               .count(aoc::execution::par) };
+    auto const expected_line_count{ std::count_if(numbers.cbegin(), numbers.cbegin() + 10'000, IS_EVEN) };
+    REQUIRE(line_count == static_cast<std::size_t>(expected_line_count));
+
+    // a LineStream is read chunk by chunk : in one chunk, or in many that the reader hands out to the other tasks
+    auto const stream_path{ (std::filesystem::temp_directory_path() / "aoc_pipeline_test.txt").string() };
+    std::ofstream{ stream_path, std::ios::trunc } << text;
+    static auto constexpr PARSE = [](aoc::StringView const & line) { return line.parse<int>(); };
+    auto const expected_line_sum{ std::accumulate(numbers.cbegin(), numbers.cbegin() + 10'000, std::int64_t{}) };
+    for (std::size_t const chunk_size : { std::size_t{ 512 }, aoc::LineStream::DEFAULT_CHUNK_SIZE }) {
+        for (auto const is_parallel : { false, true }) {
+            aoc::LineStream stream{ stream_path.c_str(), chunk_size };
+            auto const pipeline_evens{ aoc::make_pipeline(stream).on(pool).transform(PARSE).filter(IS_EVEN) };
+            auto const evens_count{ is_parallel ? pipeline_evens.count(aoc::execution::par) : pipeline_evens.count() };
+            REQUIRE(evens_count == static_cast<std::size_t>(expected_line_count));
+        }
+        aoc::LineStream stream{ stream_path.c_str(), chunk_size };
+        REQUIRE(aoc::make_pipeline(stream)
+                    .on(pool)
+                    .transform([](aoc::StringView const & line) { return std::int64_t{ PARSE(line) }; })
+                    .reduce(aoc::execution::par, std::int64_t{}, std::plus())
+                == expected_line_sum);
+    }
+
+    // stages that wait for tasks of their own, which may pick up the tasks of the pipeline
+    aoc::LineStream nested_stream{ stream_path.c_str(), 512 };
+    auto const nested_count{ aoc::make_pipeline(nested_stream)
+                                 .on(pool)
+                                 .filter([&](aoc::StringView const & line) {
+                                     std::atomic<int> is_even{};
+                                     pool.for_each_index(2, [&](std::size_t const i) {
+                                         if (i == 0) {
+                                             is_even = IS_EVEN(PARSE(line));
+                                         }
+                                     });
+                                     return is_even.load() != 0;
+                                 })
+                                 .count(aoc::execution::par) };
+    REQUIRE(nested_count == static_cast<std::size_t>(expected_line_count));
+    std::filesystem::remove(stream_path);
+    aoc::LineStream stream{ inputs::TEST_1_A_1, 8 };
+    REQUIRE(aoc::make_pipeline(stream)
+                .transform([](aoc::StringView const & line) { return line.parse<int>(); })
+                .collect()
+            == std::vector<int>{ 1721, 979, 366, 299, 675, 1456 });
+
+    // tiny and empty sources run on the calling thread
+    std::vector<int> const few{ 3, 1, 2 };
+    REQUIRE(aoc::make_pipeline(few).on(pool).max(aoc::execution::par) == 3);
+    std::vector<int> const empty{};
+    REQUIRE(!aoc::make_pipeline(empty).on(pool).max(aoc::execution::par));
+    REQUIRE(aoc::make_pipeline(empty).reduce(aoc::execution::par, 5, std::plus()) == 5);
+}
+
+//==============================================================================
+TEST_CASE("SIMD reductions")
+{
+    std::mt19937_64 generator{ 47 };
+    // every remainder of the vector loops, and enough 32 bits elements to overflow a 32 bits sum
+    for (std::size_t const size : { 0, 1, 3, 4, 7, 8, 9, 15, 17, 31, 33, 1000 }) {
+        std::vector<std::uint32_t> unsigned_32(size);
+        std::vector<std::int32_t> signed_32(size);
+        std::vector<std::uint64_t> unsigned_64(size);
+        std::vector<std::int64_t> signed_64(size);
+        for (std::size_t i{}; i < size; ++i) {
+            auto const random{ generator() };
+            unsigned_32[i] = random % 3 == 0 ? 3 : static_cast<std::uint32_t>(random >> 32);
+            signed_32[i] = random % 3 == 0 ? -3 : static_cast<std::int32_t>(random >> 32);
+            unsigned_64[i] = random % 3 == 0 ? 3 : random;
+            signed_64[i] = random % 3 == 0 ? -3 : static_cast<std::int64_t>(random);
+        }
+
+        REQUIRE(aoc::count(unsigned_32, 3u) == std::count(unsigned_32.cbegin(), unsigned_32.cend(), 3u));
+        REQUIRE(aoc::count(signed_32, -3) == std::count(signed_32.cbegin(), signed_32.cend(), -3));
+        REQUIRE(aoc::count(unsigned_64, 3) == std::count(unsigned_64.cbegin(), unsigned_64.cend(), 3));
+        REQUIRE(aoc::count(signed_64, -3) == std::count(signed_64.cbegin(), signed_64.cend(), -3));
+        // -3 isn't an unsigned value : std::count() compares after promotion
+        REQUIRE(aoc::count(unsigned_64, -3) == std::count(unsigned_64.cbegin(), unsigned_64.cend(), -3));
+
+        REQUIRE(aoc::reduce(unsigned_32, std::uint64_t{ 5 }, std::plus())
+                == std::accumulate(unsigned_32.cbegin(), unsigned_32.cend(), std::uint64_t{ 5 }));
+        REQUIRE(aoc::reduce(unsigned_32, 5u, std::plus())
+                == std::accumulate(unsigned_32.cbegin(), unsigned_32.cend(), 5u));
+        REQUIRE(aoc::reduce(signed_32, std::int64_t{ -5 }, std::plus())
+                == std::accumulate(signed_32.cbegin(), signed_32.cend(), std::int64_t{ -5 }));
+        REQUIRE(aoc::reduce(unsigned_64, std::uint64_t{ 5 }, std::plus<std::uint64_t>())
+                == std::accumulate(unsigned_64.cbegin(), unsigned_64.cend(), std::uint64_t{ 5 }));
+        REQUIRE(aoc::reduce(signed_64, std::uint64_t{ 5 }, std::plus())
+                == std::accumulate(signed_64.cbegin(), signed_64.cend(), std::uint64_t{ 5 }));
+    }
+}
+
+//==============================================================================
+TEST_CASE("cpu")
+{
+    auto const level{ aoc::cpu::level() };
+    auto const & features{ aoc::cpu::features() };
+    if (level >= aoc::cpu::Level::V3) {
+        REQUIRE((features.avx2 && features.bmi2 && features.popcnt));
+    }
+    if (level >= aoc::cpu::Level::V4) {
+        REQUIRE(features.avx512bw);
+    }
+    auto const * const cap{ std::getenv("AOC_CPU_LEVEL") };
+    if (cap != nullptr && std::string_view{ cap } == "baseline") {
+        REQUIRE(level == aoc::cpu::Level::BASELINE);
+    }
+    REQUIRE(std::string_view{ aoc::cpu::level_name(aoc::cpu::Level::V3) } == "v3");
+
+    for (std::size_t const size : { 0, 1, 7, 8, 15, 16, 17, 63, 64, 65, 1001 }) {
+        std::vector<std::uint32_t> destination(size);
+        std::vector<std::uint32_t> source(size);
+        std::iota(destination.begin(), destination.end(), 1u);
+        std::iota(source.begin(), source.end(), 1000u);
+        aoc::detail::add_cells(destination.data(), source.data(), size);
+        for (std::size_t i{}; i < size; ++i) {
+            REQUIRE(destination[i] == 2 * i + 1001);
+        }
+    }
+}
+
+//==============================================================================
+TEST_CASE("Huge_Page_Allocator")
+{
+    // below one huge page, from std::allocator
+    std::vector<std::uint32_t, aoc::Huge_Page_Allocator<std::uint32_t>> small(1000, 7);
+    REQUIRE(small[999] == 7);
+
+    static constexpr std::size_t LARGE_SIZE = aoc::detail::HUGE_PAGE_SIZE / sizeof(std::uint32_t) * 3 + 5;
+    std::vector<std::uint32_t, aoc::Huge_Page_Allocator<std::uint32_t>> large(LARGE_SIZE);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(large.data()) % aoc::detail::HUGE_PAGE_SIZE == 0);
+    REQUIRE(std::all_of(large.cbegin(), large.cend(), [](std::uint32_t const value) { return value == 0; }));
+    std::iota(large.begin(), large.end(), 0u);
+    REQUIRE(large.back() == LARGE_SIZE - 1);
+
+    // grows through a new mapping, and frees the old one
+    large.resize(LARGE_SIZE * 2, 1);
+    REQUIRE(large[LARGE_SIZE - 1] == LARGE_SIZE - 1);
+    REQUIRE(large.back() == 1);
+}
+
+//==============================================================================
+TEST_CASE("BinaryCache")
+{
+    static constexpr aoc::Cache_Schema SCHEMA{ 0, 1 };
+    auto const source_path{ (std::filesystem::temp_directory_path() / "aoc_binary_cache_test.txt").string() };
+    auto const cache_path{ source_path + aoc::BinaryCache::EXTENSION };
+    std::filesystem::remove(cache_path);
+    std::ofstream{ source_path, std::ios::trunc } << "1,2,3";
+
+    {
+        aoc::BinaryCache const cache{ source_path.c_str(), SCHEMA };
+        REQUIRE(!cache.is_loaded());
+        aoc::BinaryWriter writer{};
+        writer.write_string("name");
+        writer.write_array(std::vector<std::uint16_t>{ 1, 2, 3 });
+        writer.write(std::uint8_t{ 42 });
+        cache.store(writer);
+    }
+    {
+        aoc::BinaryCache const cache{ source_path.c_str(), SCHEMA };
+        REQUIRE(cache.is_loaded());
+        auto reader{ cache.reader() };
+        REQUIRE(reader.read_string() == "name");
+        REQUIRE(reader.read_array<std::uint16_t>().to_vector() == std::vector<std::uint16_t>{ 1, 2, 3 });
+        REQUIRE(reader.read<std::uint8_t>() == 42);
+    }
+
+    // touched : same contents under another time stamp
+    auto const modification_time{ std::filesystem::last_write_time(source_path) };
+    std::filesystem::last_write_time(source_path, modification_time - std::chrono::hours{ 1 });
+    REQUIRE(aoc::BinaryCache{ source_path.c_str(), SCHEMA }.is_loaded());
+
+    REQUIRE(!aoc::BinaryCache{ source_path.c_str(), aoc::Cache_Schema{ 0, 2 } }.is_loaded());
+    std::ofstream{ source_path, std::ios::trunc } << "1,2,4";
+    REQUIRE(!aoc::BinaryCache{ source_path.c_str(), SCHEMA }.is_loaded());
+
+    std::filesystem::remove(cache_path);
+    std::filesystem::remove(source_path);
+}
+
 //==============================================================================
 #ifdef NDEBUG
 TEST_CASE("Benchmarks")
@@ -302,4 +1455,113 @@ TEST_CASE("Benchmarks")
         return result;
     };
 }
+
+//==============================================================================
+// Cube counts as in day 17, and joltage differences as in day 10.
+TEST_CASE("SIMD reduction benchmarks")
+{
+    std::vector<unsigned> cubes(1 << 16);
+    std::vector<std::size_t> differences(1 << 16);
+    std::mt19937 generator{ 17 };
+    for (std::size_t i{}; i < cubes.size(); ++i) {
+        cubes[i] = generator() % 4 == 0 ? 1 : 0;
+        differences[i] = generator() % 2 == 0 ? 1 : 3;
+    }
+
+    BENCHMARK("std::count unsigned") { return std::count(cubes.cbegin(), cubes.cend(), 1u); };
+    BENCHMARK("aoc::count unsigned") { return aoc::count(cubes, 1u); };
+    BENCHMARK("std::count size_t") { return std::count(differences.cbegin(), differences.cend(), std::size_t{ 1 }); };
+    BENCHMARK("aoc::count size_t") { return aoc::count(differences, std::size_t{ 1 }); };
+    BENCHMARK("std::reduce unsigned")
+    {
+        return std::reduce(cubes.cbegin(), cubes.cend(), std::uint64_t{}, std::plus());
+    };
+    BENCHMARK("aoc::reduce unsigned") { return aoc::reduce(cubes, std::uint64_t{}, std::plus()); };
+    BENCHMARK("std::reduce size_t")
+    {
+        return std::reduce(differences.cbegin(), differences.cend(), std::size_t{}, std::plus());
+    };
+    BENCHMARK("aoc::reduce size_t") { return aoc::reduce(differences, std::size_t{}, std::plus()); };
+}
+
+//==============================================================================
+// The game of day 15 part b : a 120 MB table, read and written at random.
+TEST_CASE("Huge_Page_Allocator benchmarks")
+{
+    static constexpr std::uint32_t NUM_TURNS = 30'000'000;
+    auto const play = [](auto & numbers) {
+        numbers.resize(NUM_TURNS);
+        std::uint32_t last_number{};
+        for (std::uint32_t turn{ 1 }; turn < NUM_TURNS; ++turn) {
+            auto & mentioned_at_turn{ numbers[last_number] };
+            last_number = mentioned_at_turn == 0 ? 0 : turn - mentioned_at_turn;
+            mentioned_at_turn = turn;
+        }
+        return last_number;
+    };
+
+    // the counts go to the report, since the benchmarks only time
+    auto const count_events = [&](char const * name, auto numbers) {
+        aoc::PerfCounter dtlb_misses{ aoc::PerfCounter::Event::DTLB_LOAD_MISSES };
+        aoc::PerfCounter page_faults{ aoc::PerfCounter::Event::PAGE_FAULTS };
+        dtlb_misses.start();
+        page_faults.start();
+        auto const result{ play(numbers) };
+        auto const num_page_faults{ page_faults.stop() };
+        auto const num_dtlb_misses{ dtlb_misses.stop() };
+        WARN(name << " : "
+                  << (dtlb_misses.is_available() ? std::to_string(num_dtlb_misses) : std::string{ "unavailable" })
+                  << " dTLB load misses, "
+                  << (page_faults.is_available() ? std::to_string(num_page_faults) : std::string{ "unavailable" })
+                  << " page faults");
+        return result;
+    };
+    REQUIRE(count_events("std::allocator", std::vector<std::uint32_t>{})
+            == count_events("aoc::Huge_Page_Allocator",
+                            std::vector<std::uint32_t, aoc::Huge_Page_Allocator<std::uint32_t>>{}));
+
+    BENCHMARK("std::allocator")
+    {
+        std::vector<std::uint32_t> numbers{};
+        return play(numbers);
+    };
+    BENCHMARK("aoc::Huge_Page_Allocator")
+    {
+        std::vector<std::uint32_t, aoc::Huge_Page_Allocator<std::uint32_t>> numbers{};
+        return play(numbers);
+    };
+}
+
+//==============================================================================
+// Writes to 36 bits addresses, as in day 14 part b.
+TEST_CASE("Flat_Map benchmarks")
+{
+    std::vector<std::uint64_t> addresses(1 << 17);
+    std::uint64_t state{ 14 };
+    for (auto & address : addresses) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        address = (state >> 28) & 0xFFFFF00FF;
+    }
+
+    BENCHMARK("std::unordered_map")
+    {
+        std::unordered_map<std::uint64_t, std::uint64_t> memory{};
+        for (auto const address : addresses) {
+            memory[address] = address;
+        }
+        std::uint64_t sum{};
+        for (auto const & [address, value] : memory) {
+            sum += value;
+        }
+        return sum;
+    };
+    BENCHMARK("aoc::Flat_Map")
+    {
+        aoc::Flat_Map<std::uint64_t, std::uint64_t> memory{};
+        for (auto const address : addresses) {
+            memory[address] = address;
+        }
+        return memory.sum_values();
+    };
+}
 #endif